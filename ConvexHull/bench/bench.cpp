@@ -0,0 +1,258 @@
+// Runs every hull engine over the distributions of generator.h
+// (uniform-square, uniform-disk, on-circle, gaussian, clustered,
+// near-collinear) at sizes 10, 100, ... and writes one JSON record per
+// (engine, distribution, size): time per point, heap allocations per run
+// and the peak resident set.
+//
+//   hullbench [--max-size N] [--min-time SECONDS] [--engines a,b] [--distributions a,b]
+//             [--seed S] [--out FILE]
+//
+// Allocations are counted by replacing the global operator new. Peak RSS is
+// VmHWM from /proc/self/status, reset before every case through
+// /proc/self/clear_refs where the kernel allows it; elsewhere it is the
+// process peak so far.
+
+#include "generator.h"
+#include "hullengine.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <string>
+#include <thread>
+#include <vector>
+#include <sys/resource.h>
+
+// allocation counters behind the replaced global operator new
+static std::atomic<std::int64_t> allocationCount{0};
+static std::atomic<std::int64_t> allocatedBytes{0};
+
+static void *countedAllocate(std::size_t size, std::size_t alignment)
+{
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    allocatedBytes.fetch_add(std::int64_t(size), std::memory_order_relaxed);
+    if (size == 0) size = 1;
+    void *p = nullptr;
+    if (alignment <= alignof(std::max_align_t)) {
+        p = std::malloc(size);
+    } else if (posix_memalign(&p, alignment, size) != 0) {
+        p = nullptr;
+    }
+    if (!p) throw std::bad_alloc();
+    return p;
+}
+
+void *operator new(std::size_t size) { return countedAllocate(size, 0); }
+void *operator new[](std::size_t size) { return countedAllocate(size, 0); }
+void *operator new(std::size_t size, std::align_val_t a) { return countedAllocate(size, std::size_t(a)); }
+void *operator new[](std::size_t size, std::align_val_t a) { return countedAllocate(size, std::size_t(a)); }
+void operator delete(void *p) noexcept { std::free(p); }
+void operator delete[](void *p) noexcept { std::free(p); }
+void operator delete(void *p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void *p, std::size_t) noexcept { std::free(p); }
+void operator delete(void *p, std::align_val_t) noexcept { std::free(p); }
+void operator delete[](void *p, std::align_val_t) noexcept { std::free(p); }
+void operator delete(void *p, std::size_t, std::align_val_t) noexcept { std::free(p); }
+void operator delete[](void *p, std::size_t, std::align_val_t) noexcept { std::free(p); }
+
+namespace {
+
+// ---- engines ----
+
+struct Engine
+{
+    const char *name;
+    void (*run)(hull::PointsView points, bool count, std::int64_t &iterations, std::vector<int> &outHull);
+    std::size_t maxSize;        // larger inputs are skipped
+    std::size_t maxSizeAllHull; // cap when every point is on the hull (O(nh) engines)
+};
+
+template <hull::Algorithm algorithm, hull::AngularSort sort = hull::AngularSort::Comparison>
+void runFast(hull::PointsView points, bool count, std::int64_t &iterations, std::vector<int> &outHull)
+{
+    hull::HullOptions options;
+    options.angularSort = sort;
+    options.countIterations = count;
+    hull::computeHull(algorithm, points, iterations, outHull, nullptr, options);
+}
+
+template <hull::Reference reference>
+void runReference(hull::PointsView points, bool count, std::int64_t &iterations, std::vector<int> &outHull)
+{
+    hull::HullOptions options;
+    options.countIterations = count;
+    hull::computeReference(reference, points, iterations, outHull, nullptr, options);
+}
+
+constexpr std::size_t unlimited = std::size_t(-1);
+
+const Engine engines[] = {
+    {"graham", runFast<hull::Algorithm::GrahamScan>, unlimited, unlimited},
+    {"graham-radix", runFast<hull::Algorithm::GrahamScan, hull::AngularSort::Radix>, unlimited, unlimited},
+    {"monotone", runFast<hull::Algorithm::MonotoneChain>, unlimited, unlimited},
+    {"parallel", runFast<hull::Algorithm::ParallelGraham>, unlimited, unlimited},
+    {"chan", runFast<hull::Algorithm::Chan>, unlimited, unlimited},
+    {"quickhull", runFast<hull::Algorithm::QuickHull>, unlimited, unlimited},
+    {"gift", runReference<hull::Reference::GiftWrapping>, 10000000, 100000},
+    {"brute", runReference<hull::Reference::BruteForce>, 10000, 1000},
+};
+
+// ---- measurement ----
+
+void resetPeakRss()
+{
+    if (std::FILE *f = std::fopen("/proc/self/clear_refs", "w")) {
+        std::fputs("5", f);
+        std::fclose(f);
+    }
+}
+
+long peakRssKb()
+{
+    if (std::FILE *f = std::fopen("/proc/self/status", "r")) {
+        char line[256];
+        long kb = -1;
+        while (std::fgets(line, sizeof line, f))
+            if (std::strncmp(line, "VmHWM:", 6) == 0) kb = std::atol(line + 6);
+        std::fclose(f);
+        if (kb >= 0) return kb;
+    }
+    rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_maxrss;
+}
+
+struct Result
+{
+    const char *engine;
+    const char *distribution;
+    std::size_t n;
+    int repetitions;
+    double nsPerPointMedian;
+    double nsPerPointMin;
+    std::int64_t iterations;
+    std::size_t hullSize;
+    double allocationsPerRun;
+    double bytesPerRun;
+    long peakRssKb;
+};
+
+Result measure(const Engine &engine, hull::Distribution distribution, const hull::PointStore &points,
+               double minSeconds)
+{
+    using Clock = std::chrono::steady_clock;
+    Result r{engine.name, hull::distributionName(distribution), points.size(), 0, 0, 0, 0, 0, 0, 0, 0};
+    std::vector<int> outHull;
+    std::vector<double> seconds;
+    resetPeakRss();
+    const std::int64_t allocationsBefore = allocationCount.load();
+    const std::int64_t bytesBefore = allocatedBytes.load();
+    double elapsed = 0;
+    // at least three runs for a median, at most 1000 for tiny inputs; timed
+    // runs don't count iterations, one more run afterwards does
+    while ((r.repetitions < 3 || elapsed < minSeconds) && r.repetitions < 1000) {
+        const Clock::time_point start = Clock::now();
+        engine.run(points.view(), false, r.iterations, outHull);
+        const double s = std::chrono::duration<double>(Clock::now() - start).count();
+        seconds.push_back(s);
+        elapsed += s;
+        ++r.repetitions;
+    }
+    r.peakRssKb = peakRssKb();
+    r.allocationsPerRun = double(allocationCount.load() - allocationsBefore) / r.repetitions;
+    r.bytesPerRun = double(allocatedBytes.load() - bytesBefore) / r.repetitions;
+    engine.run(points.view(), true, r.iterations, outHull);
+    r.hullSize = outHull.size();
+    std::sort(seconds.begin(), seconds.end());
+    const double perPoint = 1e9 / double(std::max<std::size_t>(1, points.size()));
+    r.nsPerPointMedian = seconds[seconds.size() / 2] * perPoint;
+    r.nsPerPointMin = seconds.front() * perPoint;
+    return r;
+}
+
+void writeResult(std::FILE *out, const Result &r, bool first)
+{
+    std::fprintf(out,
+        "%s    {\"engine\": \"%s\", \"distribution\": \"%s\", \"n\": %zu, \"repetitions\": %d, "
+        "\"ns_per_point\": %.3f, \"ns_per_point_min\": %.3f, \"iterations\": %lld, \"hull_size\": %zu, "
+        "\"allocations_per_run\": %.1f, \"allocated_bytes_per_run\": %.0f, \"peak_rss_kb\": %ld}",
+        first ? "" : ",\n", r.engine, r.distribution, r.n, r.repetitions, r.nsPerPointMedian,
+        r.nsPerPointMin, (long long)r.iterations, r.hullSize, r.allocationsPerRun, r.bytesPerRun,
+        r.peakRssKb);
+}
+
+// true when name is listed in the comma-separated filter (empty: all)
+bool selected(const std::string &filter, const char *name)
+{
+    if (filter.empty()) return true;
+    const std::string list = "," + filter + ",";
+    return list.find("," + std::string(name) + ",") != std::string::npos;
+}
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    std::size_t maxSize = 10000000;
+    double minSeconds = 0.2;
+    std::string engineFilter;
+    std::string distributionFilter;
+    std::uint64_t seed = 1;
+    std::string output;
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if (i + 1 >= argc) {
+            std::fprintf(stderr, "usage: hullbench [--max-size N] [--min-time SECONDS] [--engines a,b] "
+                                 "[--distributions a,b] [--seed S] [--out FILE]\n");
+            return 2;
+        }
+        const char *value = argv[++i];
+        if (arg == "--max-size") maxSize = std::size_t(std::strtod(value, nullptr));
+        else if (arg == "--min-time") minSeconds = std::strtod(value, nullptr);
+        else if (arg == "--engines") engineFilter = value;
+        else if (arg == "--distributions") distributionFilter = value;
+        else if (arg == "--seed") seed = std::strtoull(value, nullptr, 10);
+        else if (arg == "--out") output = value;
+        else {
+            std::fprintf(stderr, "hullbench: unknown argument '%s'\n", arg.c_str());
+            return 2;
+        }
+    }
+
+    std::FILE *out = output.empty() ? stdout : std::fopen(output.c_str(), "w");
+    if (!out) {
+        std::fprintf(stderr, "hullbench: cannot write %s\n", output.c_str());
+        return 1;
+    }
+    std::fprintf(out, "{\n  \"context\": {\"threads\": %u, \"seed\": %llu, \"min_time_s\": %.3f},\n"
+                      "  \"benchmarks\": [\n",
+                 std::thread::hardware_concurrency(), (unsigned long long)seed, minSeconds);
+
+    bool first = true;
+    hull::PointStore points;
+    for (int d = 0; d < hull::distributionCount; ++d) {
+        const hull::Distribution distribution = hull::Distribution(d);
+        if (!selected(distributionFilter, hull::distributionName(distribution))) continue;
+        const bool allHull = distribution == hull::Distribution::OnCircle;
+        for (std::size_t n = 10; n <= maxSize; n *= 10) {
+            // same points for every engine; generating them isn't measured
+            hull::generatePoints(distribution, seed, n, points);
+            for (const Engine &engine : engines) {
+                if (!selected(engineFilter, engine.name)) continue;
+                if (n > (allHull ? engine.maxSizeAllHull : engine.maxSize)) continue;
+                const Result r = measure(engine, distribution, points, minSeconds);
+                writeResult(out, r, first);
+                std::fflush(out);
+                first = false;
+                std::fprintf(stderr, "%-14s %-15s n=%-10zu %10.2f ns/point\n",
+                             r.engine, r.distribution, r.n, r.nsPerPointMedian);
+            }
+        }
+    }
+    std::fprintf(out, "\n  ]\n}\n");
+    if (out != stdout) std::fclose(out);
+    return 0;
+}
@@ -0,0 +1,11 @@
+# Benchmark of every hull engine over the standard input distributions;
+# writes JSON. Needs no Qt, like hullengine.pro:
+#   qmake bench.pro && make && ./hullbench --out results.json
+TEMPLATE = app
+TARGET   = hullbench
+CONFIG  += console c++17 thread
+CONFIG  -= qt app_bundle
+
+SOURCES += bench.cpp
+
+include(../hullengine/hullengine.pri)
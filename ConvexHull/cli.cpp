@@ -0,0 +1,309 @@
+#include "cli.h"
+#include "generator.h"
+#include "hullengine.h"
+#include "trace.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace {
+
+struct EngineName
+{
+    const char *name;
+    bool reference;
+    int engine; // hull::Algorithm or hull::Reference
+};
+
+const EngineName engineNames[] = {
+    {"graham",    false, int(hull::Algorithm::GrahamScan)},
+    {"monotone",  false, int(hull::Algorithm::MonotoneChain)},
+    {"parallel",  false, int(hull::Algorithm::ParallelGraham)},
+    {"chan",      false, int(hull::Algorithm::Chan)},
+    {"quickhull", false, int(hull::Algorithm::QuickHull)},
+    {"gift",      true,  int(hull::Reference::GiftWrapping)},
+    {"brute",     true,  int(hull::Reference::BruteForce)},
+};
+
+struct Options
+{
+    std::string input;
+    std::size_t generate = 0; // points to generate instead of reading input
+    hull::Distribution distribution = hull::Distribution::UniformSquare;
+    std::uint64_t seed = 1;
+    std::string output;
+    const EngineName *engine = &engineNames[0];
+    bool prefilter = false;
+    std::string trace; // Chrome trace of the run goes here when set
+    hull::HullOptions hullOptions;
+};
+
+void printUsage(std::FILE *to)
+{
+    std::fprintf(to,
+        "usage: convexhull (--input FILE | --generate N [--distribution NAME] [--seed S])\n"
+        "                  [--algo NAME] [--out FILE] [--radix] [--prefilter] [--trace FILE]\n"
+        "  --generate   N synthetic points; --distribution is uniform-square (default),\n"
+        "               uniform-disk, on-circle, gaussian, clustered or near-collinear\n"
+        "  --algo       graham (default), monotone, parallel, chan, quickhull, gift, brute\n"
+        "  --out        write the hull here instead of to stdout\n"
+        "  --radix      radix-sorted angular order for the Graham engines\n"
+        "  --prefilter  drop points inside the Akl-Toussaint octagon first\n"
+        "  --trace      write a Chrome trace (chrome://tracing, ui.perfetto.dev) of the run\n"
+        "FILEs ending in .bin are float64 x,y pairs; anything else is text, one point per line.\n");
+}
+
+bool isBinary(const std::string &path)
+{
+    return path.size() >= 4 && path.compare(path.size() - 4, 4, ".bin") == 0;
+}
+
+bool readFile(const std::string &path, std::string &data)
+{
+    std::FILE *f = std::fopen(path.c_str(), "rb");
+    if (!f) return false;
+    char buffer[1 << 16];
+    std::size_t got;
+    while ((got = std::fread(buffer, 1, sizeof buffer, f)) > 0) data.append(buffer, got);
+    const bool ok = !std::ferror(f);
+    std::fclose(f);
+    return ok;
+}
+
+// false with a message in error when the file can't be read or parsed
+bool readPoints(const std::string &path, hull::PointStore &points, std::string &error)
+{
+    std::string data;
+    if (!readFile(path, data)) {
+        error = "cannot read " + path;
+        return false;
+    }
+
+    if (isBinary(path)) {
+        if (data.size() % (2 * sizeof(double)) != 0) {
+            error = path + ": size is not a multiple of 16 bytes";
+            return false;
+        }
+        const std::size_t n = data.size() / (2 * sizeof(double));
+        points.resize(n);
+        for (std::size_t i = 0; i < n; ++i) {
+            double xy[2];
+            std::memcpy(xy, data.data() + i * sizeof xy, sizeof xy);
+            points.set(i, xy[0], xy[1]);
+        }
+        return true;
+    }
+
+    // one point per line: two numbers separated by whitespace or a comma,
+    // optionally followed by a # comment; blank and comment lines are skipped
+    auto blank = [](char c) { return c == ' ' || c == '\t' || c == '\r'; };
+    int line = 1;
+    const char *p = data.c_str();
+    const char *const stop = p + data.size();
+    for (; p < stop; ++p, ++line) {
+        while (blank(*p)) ++p;
+        if (*p == '#') p = std::find(p, stop, '\n');
+        if (*p == '\n' || p == stop) continue;
+
+        double xy[2] = {0, 0};
+        bool ok = true;
+        for (int i = 0; i < 2 && ok; ++i) {
+            if (i == 1) {
+                const char *separator = p;
+                while (blank(*p)) ++p;
+                if (*p == ',') ++p;
+                while (blank(*p)) ++p;
+                ok = p != separator;
+            }
+            // strtod skips leading newlines too, so it only ever starts on
+            // the number itself
+            char *end;
+            xy[i] = std::strtod(p, &end);
+            ok = ok && end != p && !blank(*p) && *p != '\n' && std::isfinite(xy[i]);
+            p = end;
+        }
+        while (blank(*p)) ++p;
+        if (*p == '#') p = std::find(p, stop, '\n');
+        if (!ok || (*p != '\n' && p != stop)) {
+            error = path + ":" + std::to_string(line) + ": expected two numbers";
+            return false;
+        }
+        points.append(xy[0], xy[1]);
+    }
+    return true;
+}
+
+bool writeHull(std::FILE *to, bool binary, const hull::PointStore &points, const std::vector<int> &hullIndices)
+{
+    for (int i : hullIndices) {
+        const hull::Point p = points[i];
+        if (binary) {
+            const double xy[2] = {p.x, p.y};
+            if (std::fwrite(xy, sizeof xy, 1, to) != 1) return false;
+        } else if (std::fprintf(to, "%d %.17g %.17g\n", i, p.x, p.y) < 0) {
+            return false;
+        }
+    }
+    return std::fflush(to) == 0;
+}
+
+// 0 on success, otherwise the exit code, with the reason printed
+int parseArguments(int argc, char *argv[], Options &options)
+{
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        auto value = [&](std::string &to) {
+            if (i + 1 >= argc) {
+                std::fprintf(stderr, "convexhull: %s needs a value\n", arg.c_str());
+                return false;
+            }
+            to = argv[++i];
+            return true;
+        };
+        if (arg == "--help" || arg == "-h") {
+            printUsage(stdout);
+            return -1;
+        } else if (arg == "--input") {
+            if (!value(options.input)) return 2;
+        } else if (arg == "--generate" || arg == "--seed") {
+            std::string number;
+            if (!value(number)) return 2;
+            char *end;
+            const unsigned long long n = std::strtoull(number.c_str(), &end, 10);
+            if (number.empty() || *end) {
+                std::fprintf(stderr, "convexhull: %s needs a number\n", arg.c_str());
+                return 2;
+            }
+            if (arg == "--seed") options.seed = n;
+            else options.generate = std::size_t(n);
+        } else if (arg == "--distribution") {
+            std::string name;
+            if (!value(name)) return 2;
+            if (!hull::parseDistribution(name.c_str(), options.distribution)) {
+                std::fprintf(stderr, "convexhull: unknown distribution '%s'\n", name.c_str());
+                return 2;
+            }
+        } else if (arg == "--out") {
+            if (!value(options.output)) return 2;
+        } else if (arg == "--trace") {
+            if (!value(options.trace)) return 2;
+        } else if (arg == "--algo") {
+            std::string name;
+            if (!value(name)) return 2;
+            options.engine = nullptr;
+            for (const EngineName &e : engineNames)
+                if (name == e.name) options.engine = &e;
+            if (!options.engine) {
+                std::fprintf(stderr, "convexhull: unknown algorithm '%s'\n", name.c_str());
+                return 2;
+            }
+        } else if (arg == "--radix") {
+            options.hullOptions.angularSort = hull::AngularSort::Radix;
+        } else if (arg == "--prefilter") {
+            options.prefilter = true;
+        } else {
+            std::fprintf(stderr, "convexhull: unknown argument '%s'\n", arg.c_str());
+            printUsage(stderr);
+            return 2;
+        }
+    }
+    if (options.input.empty() == (options.generate == 0)) {
+        printUsage(stderr);
+        return 2;
+    }
+    return 0;
+}
+
+} // namespace
+
+bool isCliInvocation(int argc, char *argv[])
+{
+    for (int i = 1; i < argc; ++i) {
+        if (!std::strcmp(argv[i], "--input") || !std::strcmp(argv[i], "--generate")
+            || !std::strcmp(argv[i], "--help") || !std::strcmp(argv[i], "-h"))
+            return true;
+    }
+    return false;
+}
+
+int runCli(int argc, char *argv[])
+{
+    Options options;
+    const int parsed = parseArguments(argc, argv, options);
+    if (parsed != 0) return parsed < 0 ? 0 : parsed;
+    if (!options.trace.empty()) {
+        hull::setTraceThreadName("main");
+        hull::startTracing();
+    }
+
+    hull::PointStore points;
+    std::string error;
+    if (options.generate > 0) {
+        hull::generatePoints(options.distribution, options.seed, options.generate, points);
+    } else {
+        hull::TraceSpan span("read input", "io");
+        if (!readPoints(options.input, points, error)) {
+            std::fprintf(stderr, "convexhull: %s\n", error.c_str());
+            return 1;
+        }
+    }
+
+    using Clock = std::chrono::steady_clock;
+    const Clock::time_point start = Clock::now();
+    hull::PointStore survivors;
+    std::vector<int> originalIndex;
+    hull::PointsView view = points.view();
+    if (options.prefilter) {
+        hull::aklToussaintFilter(view, survivors, originalIndex);
+        view = survivors.view();
+    }
+    std::vector<int> hullIndices;
+    std::int64_t iterations = 0;
+    if (options.engine->reference) {
+        hull::computeReference(hull::Reference(options.engine->engine), view, iterations, hullIndices,
+                               nullptr, options.hullOptions);
+    } else {
+        hull::computeHull(hull::Algorithm(options.engine->engine), view, iterations, hullIndices,
+                          nullptr, options.hullOptions);
+    }
+    if (options.prefilter) {
+        for (int &i : hullIndices) i = originalIndex[i];
+    }
+    const double ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+    hull::TraceSpan writeSpan("write hull", "io");
+    const bool toStdout = options.output.empty();
+    std::FILE *out = stdout;
+    if (!toStdout) {
+        out = std::fopen(options.output.c_str(), isBinary(options.output) ? "wb" : "w");
+        if (!out) {
+            std::fprintf(stderr, "convexhull: cannot write %s\n", options.output.c_str());
+            return 1;
+        }
+    }
+    bool written = writeHull(out, !toStdout && isBinary(options.output), points, hullIndices);
+    if (!toStdout) written &= std::fclose(out) == 0;
+    if (!written) {
+        std::fprintf(stderr, "convexhull: writing the hull failed\n");
+        return 1;
+    }
+    writeSpan.stop();
+
+    std::fprintf(toStdout ? stderr : stdout,
+                 "algorithm=%s points=%zu hull=%zu iterations=%lld time_ms=%.3f\n",
+                 options.engine->name, points.size(), hullIndices.size(), (long long)iterations, ms);
+
+    if (!options.trace.empty()) {
+        hull::stopTracing();
+        if (!hull::writeTrace(options.trace.c_str())) {
+            std::fprintf(stderr, "convexhull: cannot write %s\n", options.trace.c_str());
+            return 1;
+        }
+    }
+    return 0;
+}
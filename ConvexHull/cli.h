@@ -0,0 +1,27 @@
+#ifndef CLI_H
+#define CLI_H
+
+// Command-line batch mode. main() checks for it before creating the
+// QApplication, so runs from cron jobs or containers need no display and
+// no Qt platform plugin; nothing here touches Qt.
+//
+//   convexhull --input pts.bin [--algo graham] [--out hull.bin]
+//              [--radix] [--prefilter] [--trace run.json]
+//   convexhull --generate 10000000 [--distribution gaussian] [--seed 7] ...
+//
+// Point files ending in .bin hold little-endian float64 pairs x0 y0 x1 y1 ...;
+// anything else is text with one "x y" (or "x,y") per line and # comments.
+// The hull is written as the input format of --out: vertex coordinates for
+// .bin, "index x y" lines otherwise, and as text to stdout without --out.
+// A summary line with the timing goes to stdout, or to stderr when stdout
+// carries the hull. --generate replaces the input with a seeded synthetic
+// cloud from generator.h, identical for identical arguments. --trace records
+// the run with trace.h and writes the Chrome trace when it is done.
+
+// true when the arguments ask for the command-line mode
+bool isCliInvocation(int argc, char *argv[]);
+
+// runs the command line and returns the process exit code
+int runCli(int argc, char *argv[]);
+
+#endif // CLI_H
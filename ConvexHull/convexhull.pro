@@ -1,12 +1,17 @@
-QT       += widgets
+QT       += widgets concurrent
 CONFIG   += c++17
 
 SOURCES += main.cpp \
            mainwindow.cpp \
-           drawingwidget.cpp
+           drawingwidget.cpp \
+           cli.cpp
 
 HEADERS += mainwindow.h \
-           drawingwidget.h
+           drawingwidget.h \
+           cli.h
+
+# headless hull engine (also buildable on its own via hullengine/hullengine.pro)
+include(hullengine/hullengine.pri)
 
 # uncomment if you want to use resources
 # RESOURCES += resources.qrc
@@ -1,57 +1,177 @@
 #include "drawingwidget.h"
+#include "hullengine.h"
+#include "taskpool.h"
+#include "trace.h"
+#include <QImage>
 #include <QPainter>
 #include <QMouseEvent>
+#include <QTimer>
+#include <QtConcurrent>
 #include <algorithm>
-#include <set>
-#include <cmath>
+
+// the dynamic hull takes tens of microseconds per insertion, so rebuilding
+// it for a bigger cloud would stall the GUI
+static const int maxLiveRebuild = 10000;
 
 DrawingWidget::DrawingWidget(QWidget *parent)
     : QWidget(parent),
+      fastEngine(hull::Algorithm::GrahamScan),
+      fastEngineRun(hull::Algorithm::GrahamScan),
+      referenceEngine(hull::Reference::BruteForce),
+      referenceEngineRun(hull::Reference::BruteForce),
+      prefilter(false),
+      survivorsRun(-1),
+      live(false),
       iterationsFast(0),
-      iterationsSlow(0)
+      iterationsSlow(0),
+      progressTimer(new QTimer(this)),
+      generation(0),
+      running(false),
+      progress(0)
 {
     setAutoFillBackground(true);
     setBackgroundRole(QPalette::Base);
+
+    qRegisterMetaType<HullRunResult>("HullRunResult");
+    // the worker emits from its own thread; queue the result onto ours
+    connect(this, &DrawingWidget::hullsComputed, this, &DrawingWidget::applyResult, Qt::QueuedConnection);
+
+    progressTimer->setInterval(50);
+    connect(progressTimer, &QTimer::timeout, this, &DrawingWidget::pollProgress);
+}
+
+DrawingWidget::~DrawingWidget()
+{
+    // workers emit through this object, so they must finish before we go;
+    // all but the latest were cancelled when they were superseded
+    if (control) control->cancelled = true;
+    for (QFuture<void> &job : jobs) job.waitForFinished();
 }
 
 void DrawingWidget::mousePressEvent(QMouseEvent *event)
 {
-    if (event->button() == Qt::LeftButton) {
-        QPointF p = event->position(); // Qt 6: use position(); for Qt5 use event->posF()
+    QPointF p = event->position(); // Qt 6: use position(); for Qt5 use event->posF()
 #ifdef QT_VERSION_MAJOR
 #if QT_VERSION_MAJOR < 6
-        p = event->posF();
+    p = event->posF();
 #endif
 #endif
-        points.append(p);
+    if (event->button() == Qt::LeftButton) {
+        points.append(p.x(), p.y());
+        if (live) {
+            liveHull.insert(p.x(), p.y(), int(points.size()) - 1);
+            liveHull.vertices(hullLive);
+        }
         // reset hulls until user presses Run again
-        hullFast.clear();
-        hullSlow.clear();
-        iterationsFast = iterationsSlow = 0;
+        resetHulls();
         update();
+    } else if (event->button() == Qt::RightButton) {
+        const int i = pointNear(p, 8);
+        if (i < 0) return;
+        removePoint(i);
+        resetHulls();
+        update();
+    }
+}
+
+int DrawingWidget::pointNear(const QPointF &pos, qreal radius) const
+{
+    int nearest = -1;
+    qreal best = radius * radius;
+    for (int i = 0; i < int(points.size()); ++i) {
+        const QPointF d = pointAt(i) - pos;
+        const qreal d2 = QPointF::dotProduct(d, d);
+        if (d2 <= best) {
+            best = d2;
+            nearest = i;
+        }
+    }
+    return nearest;
+}
+
+// removes point i by moving the last point into its slot, so only one index
+// changes; the live hull follows with remove and relabel
+void DrawingWidget::removePoint(int i)
+{
+    const int last = int(points.size()) - 1;
+    if (live) {
+        liveHull.remove(points.xs()[i], points.ys()[i], i);
+        if (i != last) liveHull.relabel(points.xs()[last], points.ys()[last], last, i);
+    }
+    points.set(i, points.xs()[last], points.ys()[last]);
+    points.resize(last);
+    if (live) liveHull.vertices(hullLive);
+}
+
+void DrawingWidget::resetHulls()
+{
+    invalidateRun();
+    hullFast.clear();
+    hullSlow.clear();
+    iterationsFast = iterationsSlow = 0;
+    profileFast.clear();
+    profileSlow.clear();
+    survivorsRun = -1;
+}
+
+// one overlay line per phase the run went through
+static QString phaseLines(const char *engine, const hull::RunProfile &profile)
+{
+    QString lines;
+    for (int p = 0; p < hull::phaseCount; ++p) {
+        const hull::PhaseStats &s = profile[hull::Phase(p)];
+        if (s.calls == 0) continue;
+        lines += QString("\n%1 %2: %3 ms").arg(engine).arg(hull::phaseName(hull::Phase(p))).arg(s.seconds * 1e3, 0, 'f', 2);
+        if (s.cycles >= 0) {
+            lines += QString(", %1 Mcycles, IPC %2, %3k cache misses, %4k branch misses")
+                    .arg(s.cycles / 1e6, 0, 'f', 1)
+                    .arg(s.cycles > 0 ? double(s.instructions) / s.cycles : 0.0, 0, 'f', 2)
+                    .arg(s.cacheMisses / 1e3, 0, 'f', 1)
+                    .arg(s.branchMisses / 1e3, 0, 'f', 1);
+        }
     }
+    return lines;
 }
 
 void DrawingWidget::paintEvent(QPaintEvent * /*event*/)
 {
+    hull::TraceSpan span("paint", "gui");
     QPainter p(this);
     p.setRenderHint(QPainter::Antialiasing);
 
     // clear
     p.fillRect(rect(), Qt::white);
 
-    // draw points
+    // draw points; generated clouds of millions are plotted as single
+    // pixels into an image, one ellipse each would take seconds
+    const int maxEllipses = 20000;
     p.setPen(Qt::black);
-    for (const QPointF &pt : points) {
-        p.drawEllipse(pt, 4, 4);
+    if (int(points.size()) <= maxEllipses) {
+        for (int i = 0; i < int(points.size()); ++i) {
+            p.drawEllipse(pointAt(i), 4, 4);
+        }
+    } else {
+        QImage dots(size(), QImage::Format_ARGB32_Premultiplied);
+        dots.fill(Qt::transparent);
+        QRgb *bits = reinterpret_cast<QRgb *>(dots.bits());
+        const int stride = int(dots.bytesPerLine() / sizeof(QRgb));
+        const double *xs = points.xs();
+        const double *ys = points.ys();
+        for (std::size_t i = 0; i < points.size(); ++i) {
+            const int x = int(xs[i]);
+            const int y = int(ys[i]);
+            if (x >= 0 && x < dots.width() && y >= 0 && y < dots.height())
+                bits[y * stride + x] = qRgb(0, 0, 0);
+        }
+        p.drawImage(0, 0, dots);
     }
 
     // draw slow hull in red (opaque)
-    if (!hullSlow.isEmpty()) {
+    if (!hullSlow.empty()) {
         QPen pen(Qt::red, 2);
         p.setPen(pen);
         QPolygonF poly;
-        for (int idx : hullSlow) poly << points[idx];
+        for (int idx : hullSlow) poly << pointAt(idx);
         if (poly.size() > 1) {
             p.drawPolygon(poly);
             // close polygon
@@ -60,61 +180,79 @@ void DrawingWidget::paintEvent(QPaintEvent * /*event*/)
     }
 
     // draw fast hull in blue dashed (overlay)
-    if (!hullFast.isEmpty()) {
+    if (!hullFast.empty()) {
         QPen pen(Qt::blue, 2, Qt::DashLine);
         p.setPen(pen);
         QPolygonF poly;
-        for (int idx : hullFast) poly << points[idx];
+        for (int idx : hullFast) poly << pointAt(idx);
         if (poly.size() > 1) {
             p.drawPolygon(poly);
             p.drawLine(poly.last(), poly.first());
         }
     }
 
+    // draw live hull in green
+    if (live && hullLive.size() > 1) {
+        p.setPen(QPen(Qt::darkGreen, 1));
+        QPolygonF poly;
+        for (int idx : hullLive) poly << pointAt(idx);
+        p.drawPolygon(poly);
+    }
+
     // iteration counts and instructions
     p.setPen(Qt::black);
     QFont f = p.font();
     f.setPointSize(10);
     p.setFont(f);
 
-    QString info = QString("Points: %1\nFast (Graham) iterations: %2\nSlow (brute) iterations: %3\n\nLeft click to add points.")
-            .arg(points.size())
+    QString fastName = QString::fromLatin1(hull::algorithmName(fastEngineRun));
+    const bool graham = fastEngineRun == hull::Algorithm::GrahamScan || fastEngineRun == hull::Algorithm::ParallelGraham;
+    if (graham && engineOptionsRun.angularSort == hull::AngularSort::Radix)
+        fastName += ", radix sort";
+    QString info = QString("Points: %1\nFast (%2) iterations: %3\nSlow (%4) iterations: %5\n\nLeft click to add points, right click to delete.")
+            .arg(int(points.size()))
+            .arg(fastName)
             .arg(iterationsFast)
+            .arg(QString::fromLatin1(hull::referenceName(referenceEngineRun)))
             .arg(iterationsSlow);
+    if (graham)
+        info += QString("\nParallel sort from %1 points on %2 threads")
+                .arg(qulonglong(engineOptionsRun.parallelSortThreshold))
+                .arg(hull::TaskPool::global().threadCount());
+    if (!profileFast.empty() || !profileSlow.empty()) {
+        info += "\n";
+        bool counted = false;
+        for (int phase = 0; phase < hull::phaseCount; ++phase) {
+            counted |= profileFast[hull::Phase(phase)].cycles >= 0;
+            counted |= profileSlow[hull::Phase(phase)].cycles >= 0;
+        }
+        if (!counted) info += "\nHardware counters unavailable, wall time only";
+        info += phaseLines("Fast", profileFast) + phaseLines("Slow", profileSlow);
+    }
+    if (!generated.isEmpty())
+        info += "\n" + generated;
+    if (survivorsRun >= 0)
+        info += QString("\nPrefilter kept %1 of %2 points").arg(survivorsRun).arg(int(points.size()));
+    if (live)
+        info += QString("\nLive hull: %1 vertices, %2 tests").arg(int(hullLive.size())).arg(liveHull.iterations());
+    if (running)
+        info += QString("\nComputing... %1%").arg(progress);
     p.drawText(8, 16, info);
 }
 
 void DrawingWidget::clearAll()
 {
+    resetHulls();
     points.clear();
-    hullFast.clear();
-    hullSlow.clear();
-    iterationsFast = iterationsSlow = 0;
+    liveHull.clear();
+    hullLive.clear();
+    generated.clear();
     update();
 }
 
-double DrawingWidget::cross(const QPointF &o, const QPointF &a, const QPointF &b)
-{
-    return (a.x() - o.x()) * (b.y() - o.y()) - (a.y() - o.y()) * (b.x() - o.x());
-}
-
-double DrawingWidget::crossVec(const QPointF &a, const QPointF &b)
-{
-    return a.x()*b.y() - a.y()*b.x();
-}
-
-double DrawingWidget::dist2(const QPointF &a, const QPointF &b)
-{
-    double dx = a.x()-b.x();
-    double dy = a.y()-b.y();
-    return dx*dx + dy*dy;
-}
-
 void DrawingWidget::runBothAlgorithms()
 {
-    hullFast.clear();
-    hullSlow.clear();
-    iterationsFast = iterationsSlow = 0;
+    resetHulls();
 
     if (points.size() < 3) {
         // nothing to do
@@ -122,166 +260,209 @@ void DrawingWidget::runBothAlgorithms()
         return;
     }
 
-    computeGrahamScan(iterationsFast, hullFast);
-    computeSlowConvexHull(iterationsSlow, hullSlow);
+    // snapshot the points so clicks during the run don't race the worker
+    hull::PointStore pts = points;
+
+    control = std::make_shared<hull::RunControl>();
+    const quint64 gen = generation;
+    const hull::Algorithm engine = fastEngine;
+    const hull::Reference reference = referenceEngine;
+    hull::HullOptions options = engineOptions;
+    // cancelled runs may still be winding down and using the arena
+    options.arena = runsInFlight.load() == 0 ? &arena : nullptr;
+    runsInFlight.fetch_add(1);
+    const bool filter = prefilter;
+    std::shared_ptr<hull::RunControl> ctl = control;
+    jobs.erase(std::remove_if(jobs.begin(), jobs.end(), [](const QFuture<void> &job) { return job.isFinished(); }),
+               jobs.end());
+    jobs.append(QtConcurrent::run([this, gen, engine, reference, options, filter, ctl, pts = std::move(pts)]() {
+        hull::TraceSpan span("hull run", "gui");
+        HullRunResult result;
+        result.generation = gen;
+        result.fastAlgorithm = engine;
+        result.referenceAlgorithm = reference;
+        result.options = options;
+        if (options.arena) options.arena->reset();
+
+        // with the prefilter on, both engines only see the survivors and
+        // their hulls are mapped back to indices into pts afterwards
+        hull::PointStore survivors;
+        std::vector<int> originalIndex;
+        hull::PointsView view = pts.view();
+        if (filter) {
+            hull::aklToussaintFilter(view, survivors, originalIndex);
+            view = survivors.view();
+            result.survivors = static_cast<int>(survivors.size());
+        }
+
+        // the fast engine is negligible next to the reference
+        std::int64_t iterations = 0;
+        ctl->progressBase = 0;
+        ctl->progressSpan = 1;
+        hull::HullOptions profiled = options;
+        profiled.profile = &result.profileFast;
+        hull::computeHull(engine, view, iterations, result.hullFast, ctl.get(), profiled);
+        result.iterationsFast = iterations;
+        ctl->progressBase = 1;
+        ctl->progressSpan = 99;
+        profiled.profile = &result.profileSlow;
+        hull::computeReference(reference, view, iterations, result.hullSlow, ctl.get(), profiled);
+        result.iterationsSlow = iterations;
+
+        if (filter) {
+            for (int &i : result.hullFast) i = originalIndex[i];
+            for (int &i : result.hullSlow) i = originalIndex[i];
+        }
+        // done with the arena
+        runsInFlight.fetch_sub(1);
+
+        result.cancelled = ctl->isCancelled();
+        span.stop();
+        emit hullsComputed(result);
+    }));
 
+    progress = 0;
+    setRunning(true);
     update();
 }
 
-// Graham scan (fast) implementation. iterations counts comparisons and cross ops roughly.
-void DrawingWidget::computeGrahamScan(qint64 &iterations, QVector<int> &outHull)
+void DrawingWidget::cancelRun()
 {
-    iterations = 0;
-    int n = points.size();
-    // create indices
-    QVector<int> idx(n);
-    for (int i = 0; i < n; ++i) idx[i] = i;
-
-    // find pivot = lowest y (and lowest x if tie)
-    int pivot = 0;
-    for (int i = 1; i < n; ++i) {
-        ++iterations;
-        if (points[i].y() < points[pivot].y() || (points[i].y() == points[pivot].y() && points[i].x() < points[pivot].x()))
-            pivot = i;
-    }
+    if (!running) return;
+    invalidateRun();
+    update();
+}
 
-    QPointF p0 = points[pivot];
-    // sort by angle wrt pivot, ties by distance
-    std::sort(idx.begin(), idx.end(), [&](int a, int b){
-        if (a == pivot) return true;
-        if (b == pivot) return false;
-        QPointF va = QPointF(points[a].x() - p0.x(), points[a].y() - p0.y());
-        QPointF vb = QPointF(points[b].x() - p0.x(), points[b].y() - p0.y());
-        double cr = crossVec(va, vb);
-        ++iterations;
-        if (std::abs(cr) < 1e-9) {
-            // collinear: closer one first
-            return dist2(p0, points[a]) < dist2(p0, points[b]);
-        }
-        return cr > 0; // a before b if left of b (i.e. smaller angle)
-    });
-
-    // remove duplicates with same angle keeping farthest (typical Graham variant) OR keep as is but handle in stack
-    QVector<int> filtered;
-    for (int i = 0; i < idx.size(); ++i) {
-        if (!filtered.isEmpty() && idx[i] == pivot) continue;
-        if (filtered.isEmpty()) { filtered.append(idx[i]); continue; }
-        // if same angle as previous, keep the farthest
-        QPointF A = points[filtered.last()];
-        QPointF B = points[idx[i]];
-        QPointF VA = QPointF(A.x()-p0.x(), A.y()-p0.y());
-        QPointF VB = QPointF(B.x()-p0.x(), B.y()-p0.y());
-        double cr = crossVec(VA, VB);
-        ++iterations;
-        if (std::abs(cr) < 1e-9) {
-            // choose farthest
-            if (dist2(p0, A) < dist2(p0, B))
-                filtered.last() = idx[i];
-            // else keep existing
-        } else {
-            filtered.append(idx[i]);
-        }
+void DrawingWidget::applyResult(const HullRunResult &result)
+{
+    if (result.generation != generation) return; // stale or cancelled run
+
+    setRunning(false);
+    if (!result.cancelled) {
+        fastEngineRun = result.fastAlgorithm;
+        referenceEngineRun = result.referenceAlgorithm;
+        engineOptionsRun = result.options;
+        survivorsRun = result.survivors;
+        hullFast = result.hullFast;
+        hullSlow = result.hullSlow;
+        iterationsFast = result.iterationsFast;
+        iterationsSlow = result.iterationsSlow;
+        profileFast = result.profileFast;
+        profileSlow = result.profileSlow;
     }
+    update();
+}
 
-    if (filtered.size() < 3) {
-        // everything collinear or too small
-        outHull = filtered;
-        return;
-    }
+void DrawingWidget::setFastAlgorithm(hull::Algorithm algorithm)
+{
+    // takes effect on the next Run
+    fastEngine = algorithm;
+}
 
-    // stack
-    QVector<int> st;
-    st.append(filtered[0]);
-    st.append(filtered[1]);
-
-    for (int i = 2; i < filtered.size(); ++i) {
-        while (st.size() >= 2) {
-            int s1 = st[st.size()-2];
-            int s2 = st[st.size()-1];
-            int s3 = filtered[i];
-            ++iterations;
-            double cr = cross(points[s1], points[s2], points[s3]);
-            if (cr <= 0) { // non-left turn -> pop (use <= to exclude collinear non-left)
-                st.removeLast();
-            } else {
-                break;
-            }
-        }
-        st.append(filtered[i]);
-    }
+void DrawingWidget::setRadixSortEnabled(bool on)
+{
+    // takes effect on the next Run
+    engineOptions.angularSort = on ? hull::AngularSort::Radix : hull::AngularSort::Comparison;
+}
 
-    outHull = st;
+void DrawingWidget::setParallelSortThreshold(int points)
+{
+    // takes effect on the next Run
+    engineOptions.parallelSortThreshold = std::size_t(points);
 }
 
-// Slow brute-force convex hull: check every pair (i,j) if all points are on same side of line (i->j).
-// We accumulate endpoints of valid edges and then order unique endpoints into polygon by centroid angle.
-void DrawingWidget::computeSlowConvexHull(qint64 &iterations, QVector<int> &outHull)
+void DrawingWidget::setReferenceAlgorithm(hull::Reference reference)
 {
-    iterations = 0;
-    int n = points.size();
-    if (n < 3) return;
-
-    std::set<std::pair<int,int>> edges;
-    for (int i = 0; i < n; ++i) {
-        for (int j = i+1; j < n; ++j) {
-            bool pos = false, neg = false;
-            for (int k = 0; k < n; ++k) {
-                if (k==i || k==j) continue;
-                ++iterations;
-                double c = cross(points[i], points[j], points[k]);
-                if (c > 1e-9) pos = true;
-                else if (c < -1e-9) neg = true;
-                if (pos && neg) break; // not an edge
-            }
-            if (!(pos && neg)) {
-                // all points on one side -> (i,j) is an edge of convex hull (or collinear)
-                edges.insert({i,j});
-                edges.insert({j,i});
-            }
-        }
+    // takes effect on the next Run
+    referenceEngine = reference;
+}
+
+void DrawingWidget::setPrefilterEnabled(bool on)
+{
+    // takes effect on the next Run
+    prefilter = on;
+}
+
+void DrawingWidget::setLiveHullEnabled(bool on)
+{
+    if (live == on) return;
+    if (on && int(points.size()) > maxLiveRebuild) {
+        // too many points to catch up with; leave it off
+        emit liveHullEnabledChanged(false);
+        return;
+    }
+    live = on;
+    liveHull.clear();
+    hullLive.clear();
+    if (live) {
+        // catch up with the points added while it was off
+        for (int i = 0; i < int(points.size()); ++i)
+            liveHull.insert(points.xs()[i], points.ys()[i], i);
+        liveHull.vertices(hullLive);
     }
+    emit liveHullEnabledChanged(live);
+    update();
+}
 
-    // collect unique vertices used in edges
-    std::set<int> verts;
-    for (auto &e : edges) {
-        verts.insert(e.first);
-        verts.insert(e.second);
+void DrawingWidget::generatePoints(hull::Distribution distribution, int count, quint64 seed)
+{
+    resetHulls();
+    // a margin keeps the hull edges visible
+    const double margin = 10;
+    hull::GenerateBounds bounds;
+    bounds.x = margin;
+    bounds.y = margin;
+    bounds.width = qMax(1.0, width() - 2 * margin);
+    bounds.height = qMax(1.0, height() - 2 * margin);
+    hull::generatePoints(distribution, seed, std::size_t(qMax(0, count)), points, bounds);
+    generated = QString("Generated %1 %2 points, seed %3")
+            .arg(count).arg(QString::fromLatin1(hull::distributionName(distribution))).arg(seed);
+
+    if (live) {
+        // switched off rather than rebuilt for a big cloud
+        if (count <= maxLiveRebuild) {
+            liveHull.clear();
+            for (int i = 0; i < int(points.size()); ++i)
+                liveHull.insert(points.xs()[i], points.ys()[i], i);
+            liveHull.vertices(hullLive);
+        } else {
+            setLiveHullEnabled(false);
+        }
     }
+    update();
+}
 
-    if (verts.empty()) return;
+void DrawingWidget::pollProgress()
+{
+    if (!control) return;
+    const int p = control->progress.load(std::memory_order_relaxed);
+    if (p == progress) return;
+    progress = p;
+    emit progressChanged(progress);
+    update();
+}
 
-    QVector<QPointF> pts;
-    QVector<int> idx;
-    for (int v : verts) {
-        pts.append(points[v]);
-        idx.append(v);
+// cancels any run in flight and makes its result stale
+void DrawingWidget::invalidateRun()
+{
+    ++generation;
+    if (control) {
+        control->cancelled = true;
+        control.reset();
     }
-
-    // order vertices by angle around centroid
-    orderHullPoints(pts, idx);
-    outHull = idx;
+    setRunning(false);
 }
 
-// orders idx (indices into original points) by computing centroid and sorting by angle
-void DrawingWidget::orderHullPoints(const QVector<QPointF> &pts, QVector<int> &indices)
+void DrawingWidget::setRunning(bool on)
 {
-    int m = pts.size();
-    if (m <= 1) return;
-    // compute centroid
-    double cx = 0, cy = 0;
-    for (const QPointF &p : pts) { cx += p.x(); cy += p.y(); }
-    cx /= m; cy /= m;
-    QPointF center(cx, cy);
-
-    // build vector of pairs (angle, index)
-    std::vector<std::pair<double,int>> arr;
-    arr.reserve(m);
-    for (int i = 0; i < m; ++i) {
-        QPointF v = QPointF(pts[i].x() - center.x(), pts[i].y() - center.y());
-        double ang = std::atan2(v.y(), v.x());
-        arr.push_back({ang, indices[i]});
+    if (running == on) return;
+    running = on;
+    if (running) {
+        progressTimer->start();
+    } else {
+        progressTimer->stop();
+        progress = 0;
     }
-    std::sort(arr.begin(), arr.end(), [](const auto &a, const auto &b){ return a.first < b.first; });
-    // rewrite indices in sorted order
-    for (int i = 0; i < m; ++i) indices[i] = arr[i].second;
+    emit progressChanged(progress);
+    emit runningChanged(running);
 }
@@ -2,44 +2,145 @@
 #define DRAWINGWIDGET_H
 
 #include <QWidget>
-#include <QVector>
 #include <QPointF>
+#include <QFuture>
+#include <QList>
+#include <QMetaType>
+#include <atomic>
+#include <memory>
+#include <vector>
+#include "hullengine.h"
+#include "dynamichull.h"
+#include "generator.h"
+
+class QTimer;
+
+// result of one background run, delivered to the GUI thread by hullsComputed
+struct HullRunResult
+{
+    quint64 generation = 0;  // matches DrawingWidget::generation when still current
+    bool cancelled = false;
+    hull::Algorithm fastAlgorithm = hull::Algorithm::GrahamScan;
+    hull::Reference referenceAlgorithm = hull::Reference::BruteForce;
+    hull::HullOptions options;
+    int survivors = -1;      // points left by the prefilter, -1 when it was off
+    std::vector<int> hullFast;
+    std::vector<int> hullSlow;
+    qint64 iterationsFast = 0;
+    qint64 iterationsSlow = 0;
+    hull::RunProfile profileFast;
+    hull::RunProfile profileSlow;
+};
+Q_DECLARE_METATYPE(HullRunResult)
 
 class DrawingWidget : public QWidget
 {
     Q_OBJECT
 public:
     explicit DrawingWidget(QWidget *parent = nullptr);
+    ~DrawingWidget() override;
+
+    bool isRunning() const { return running; }
+    hull::Algorithm fastAlgorithm() const { return fastEngine; }
+    hull::Reference referenceAlgorithm() const { return referenceEngine; }
+    bool prefilterEnabled() const { return prefilter; }
+    bool radixSortEnabled() const { return engineOptions.angularSort == hull::AngularSort::Radix; }
+    int parallelSortThreshold() const { return int(engineOptions.parallelSortThreshold); }
+    bool liveHullEnabled() const { return live; }
 
     // called by mainwindow buttons
 public slots:
     void runBothAlgorithms();
+    void cancelRun();
     void clearAll();
+    void setFastAlgorithm(hull::Algorithm algorithm);
+    void setReferenceAlgorithm(hull::Reference reference);
+    void setPrefilterEnabled(bool on);
+    void setRadixSortEnabled(bool on);
+    void setParallelSortThreshold(int points);
+    void setLiveHullEnabled(bool on);
+    // replaces the points with a synthetic cloud filling the widget
+    void generatePoints(hull::Distribution distribution, int count, quint64 seed);
+
+signals:
+    void runningChanged(bool running);
+    void progressChanged(int percent);
+    void liveHullEnabledChanged(bool on);
+    // emitted from the worker thread; connected queued to applyResult
+    void hullsComputed(const HullRunResult &result);
 
 protected:
     void paintEvent(QPaintEvent *event) override;
     void mousePressEvent(QMouseEvent *event) override;
 
+private slots:
+    void applyResult(const HullRunResult &result);
+    void pollProgress();
+
 private:
-    QVector<QPointF> points;
+    // coordinates as separate x and y arrays; pointAt adapts them for QPainter
+    hull::PointStore points;
+    QPointF pointAt(int i) const { return QPointF(points.xs()[i], points.ys()[i]); }
+
+    // engine used for the fast hull
+    hull::Algorithm fastEngine;
+    hull::Algorithm fastEngineRun; // engine behind the hull currently shown
+    hull::HullOptions engineOptions;
+    hull::HullOptions engineOptionsRun;
+
+    // engine used for the slow (reference) hull
+    hull::Reference referenceEngine;
+    hull::Reference referenceEngineRun;
+
+    // run the Akl-Toussaint prefilter before both engines
+    bool prefilter;
+    int survivorsRun; // prefilter survivors behind the hulls shown, -1 if off
+
+    // live hull, updated on every click instead of on Run; dynamic so that
+    // right-click deletions don't force a rebuild
+    bool live;
+    hull::DynamicHull liveHull;
+    std::vector<int> hullLive; // indices into points, refreshed after each change
+
+    // last generated cloud for the overlay, empty if none since clearAll
+    QString generated;
 
     // hulls
-    QVector<int> hullFast; // indices into points (Graham)
-    QVector<int> hullSlow; // indices into points (from brute edges then ordered)
+    std::vector<int> hullFast; // indices into points (fast engine)
+    std::vector<int> hullSlow; // indices into points (reference engine)
 
     // iteration counts
     qint64 iterationsFast;
     qint64 iterationsSlow;
+    // per-phase time and hardware counters of the run shown
+    hull::RunProfile profileFast;
+    hull::RunProfile profileSlow;
 
-    // algorithm implementations
-    void computeGrahamScan(qint64 &iterations, QVector<int> &outHull);
-    void computeSlowConvexHull(qint64 &iterations, QVector<int> &outHull);
+    // background run state; generation is bumped whenever points change so
+    // results computed from an older snapshot are dropped
+    // every run not known to be finished; cancelled runs keep going until
+    // their next check and emit through this object, so all are waited for
+    QList<QFuture<void>> jobs;
+    // scratch memory of the engines, handed to a run only when no other run
+    // is in flight: a cancelled run keeps using it until its next
+    // cancellation check, however many runs started since
+    hull::Arena arena;
+    // runs whose engines haven't returned yet, cancelled ones included;
+    // raised on the GUI thread, lowered by the workers
+    std::atomic<int> runsInFlight{0};
+    std::shared_ptr<hull::RunControl> control;
+    QTimer *progressTimer;
+    quint64 generation;
+    bool running;
+    int progress;
 
-    // helpers
-    static double cross(const QPointF &o, const QPointF &a, const QPointF &b);
-    static double crossVec(const QPointF &a, const QPointF &b);
-    static double dist2(const QPointF &a, const QPointF &b);
-    void orderHullPoints(const QVector<QPointF> &pts, QVector<int> &indices);
+    // point within radius pixels of pos closest to it, -1 if none
+    int pointNear(const QPointF &pos, qreal radius) const;
+    void removePoint(int i);
+    // drops Run results after points changed
+    void resetHulls();
+    void invalidateRun();
+    void setRunning(bool on);
 };
 
 #endif // DRAWINGWIDGET_H
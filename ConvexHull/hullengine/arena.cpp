@@ -0,0 +1,88 @@
+#include "arena.h"
+#include <algorithm>
+#include <new>
+
+namespace hull {
+
+// blocks start on a cache line, like the point store's arrays
+static constexpr std::size_t blockAlignment = 64;
+static constexpr std::size_t minBlockBytes = std::size_t(64) << 10;
+
+Arena::Arena(std::size_t initialBytes)
+{
+    if (initialBytes > 0) addBlock(initialBytes);
+}
+
+Arena::~Arena()
+{
+    freeBlocks();
+}
+
+void Arena::reset()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    if (blocks.size() > 1) {
+        // one block for everything the last runs needed, with room for
+        // padding that lands differently once the blocks are merged
+        std::size_t total = 0;
+        for (const Block &b : blocks) total += b.size;
+        freeBlocks();
+        addBlock(total + total / 8);
+    }
+    current = 0;
+    offset = 0;
+    usedBytes = 0;
+}
+
+std::size_t Arena::used() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return usedBytes;
+}
+
+std::size_t Arena::capacity() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    std::size_t total = 0;
+    for (const Block &b : blocks) total += b.size;
+    return total;
+}
+
+std::size_t Arena::heapAllocations() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return allocations;
+}
+
+void *Arena::do_allocate(std::size_t bytes, std::size_t alignment)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    // the rest of a block too small for this request is skipped for good
+    for (;; ++current, offset = 0) {
+        if (current == blocks.size()) addBlock(bytes + alignment);
+        const Block &b = blocks[current];
+        const std::size_t start = (offset + alignment - 1) / alignment * alignment;
+        if (start + bytes <= b.size) {
+            usedBytes += start + bytes - offset;
+            offset = start + bytes;
+            return b.data + start;
+        }
+    }
+}
+
+void Arena::addBlock(std::size_t minBytes)
+{
+    const std::size_t last = blocks.empty() ? 0 : blocks.back().size;
+    const std::size_t size = std::max({minBytes, 2 * last, minBlockBytes});
+    char *data = static_cast<char *>(::operator new(size, std::align_val_t(blockAlignment)));
+    blocks.push_back({data, size});
+    ++allocations;
+}
+
+void Arena::freeBlocks()
+{
+    for (const Block &b : blocks) ::operator delete(b.data, std::align_val_t(blockAlignment));
+    blocks.clear();
+}
+
+} // namespace hull
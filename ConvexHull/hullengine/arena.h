@@ -0,0 +1,75 @@
+#ifndef HULL_ARENA_H
+#define HULL_ARENA_H
+
+#include <cstddef>
+#include <memory_resource>
+#include <mutex>
+#include <vector>
+
+namespace hull {
+
+// Monotonic memory for the scratch buffers of hull runs, handed to the
+// engines through HullOptions::arena. Allocation bumps an offset through a
+// list of blocks and deallocation does nothing; reset() makes everything
+// available again without giving it back to the heap. If a run spilled into
+// more than one block, reset() swaps them for a single block big enough for
+// all of it, so a loop of similar runs settles on one block and then runs
+// without touching the heap.
+//
+// Allocation takes a lock so the parallel engines' tasks can share one
+// arena; engines allocate a few buffers per run, never per point. reset()
+// must not race a run using the arena.
+class Arena : public std::pmr::memory_resource
+{
+public:
+    explicit Arena(std::size_t initialBytes = 0);
+    ~Arena() override;
+
+    Arena(const Arena &) = delete;
+    Arena &operator=(const Arena &) = delete;
+
+    // forgets every allocation; buffers from before must no longer be used
+    void reset();
+
+    // bytes handed out since the last reset, alignment padding included
+    std::size_t used() const;
+    // bytes held in blocks
+    std::size_t capacity() const;
+    // blocks taken from the heap over the arena's lifetime
+    std::size_t heapAllocations() const;
+
+protected:
+    void *do_allocate(std::size_t bytes, std::size_t alignment) override;
+    void do_deallocate(void *, std::size_t, std::size_t) override {}
+    bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override
+    {
+        return this == &other;
+    }
+
+private:
+    struct Block
+    {
+        char *data;
+        std::size_t size;
+    };
+
+    void addBlock(std::size_t minBytes);
+    void freeBlocks();
+
+    std::vector<Block> blocks;
+    std::size_t current = 0;   // block being filled
+    std::size_t offset = 0;    // into blocks[current]
+    std::size_t usedBytes = 0;
+    std::size_t allocations = 0;
+    mutable std::mutex mutex;
+};
+
+// where an engine takes its scratch memory from: the arena if there is one
+inline std::pmr::memory_resource *scratchResource(Arena *arena)
+{
+    return arena ? static_cast<std::pmr::memory_resource *>(arena) : std::pmr::get_default_resource();
+}
+
+} // namespace hull
+
+#endif // HULL_ARENA_H
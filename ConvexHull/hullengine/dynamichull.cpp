@@ -0,0 +1,297 @@
+#include "dynamichull.h"
+#include "predicates.h"
+#include <algorithm>
+#include <cassert>
+
+namespace hull {
+
+// lexicographic (x, y) order of the leaves
+template <typename T>
+static bool lexLess(T ax, T ay, T bx, T by)
+{
+    return ax < bx || (ax == bx && ay < by);
+}
+
+template <typename T>
+void BasicDynamicHull<T>::insert(T x, T y, int id)
+{
+    assert(inExactRange(x, y));
+    ++count;
+    if (root < 0) {
+        root = newNode();
+        nodes[root].x = x;
+        nodes[root].y = y;
+        nodes[root].ids.push_back(id);
+        return;
+    }
+
+    int leaf = root;
+    while (!isLeaf(leaf))
+        leaf = lexLess(nodes[leaf].x, nodes[leaf].y, x, y) ? nodes[leaf].right : nodes[leaf].left;
+    if (nodes[leaf].x == x && nodes[leaf].y == y) {
+        // same position as a stored point; the hull doesn't change
+        nodes[leaf].ids.push_back(id);
+        return;
+    }
+
+    // the leaf becomes a two-leaf subtree; newNode may move nodes, so only
+    // indices are held across it
+    const int added = newNode();
+    const int inner = newNode();
+    nodes[added].x = x;
+    nodes[added].y = y;
+    nodes[added].ids.push_back(id);
+    replaceChild(nodes[leaf].parent, leaf, inner);
+    const bool addedFirst = lexLess(x, y, nodes[leaf].x, nodes[leaf].y);
+    nodes[inner].left = addedFirst ? added : leaf;
+    nodes[inner].right = addedFirst ? leaf : added;
+    nodes[inner].x = nodes[nodes[inner].left].x;
+    nodes[inner].y = nodes[nodes[inner].left].y;
+    nodes[leaf].parent = inner;
+    nodes[added].parent = inner;
+    rebalanceUp(inner);
+}
+
+template <typename T>
+bool BasicDynamicHull<T>::remove(T x, T y, int id)
+{
+    const int leaf = findLeaf(x, y);
+    if (leaf < 0) return false;
+    std::vector<int> &ids = nodes[leaf].ids;
+    const auto it = std::find(ids.begin(), ids.end(), id);
+    if (it == ids.end()) return false;
+    ids.erase(it);
+    --count;
+    if (!ids.empty()) return true;
+
+    // the sibling takes the parent's place
+    const int parent = nodes[leaf].parent;
+    freeNode(leaf);
+    if (parent < 0) {
+        root = -1;
+        return true;
+    }
+    const int sibling = nodes[parent].left == leaf ? nodes[parent].right : nodes[parent].left;
+    const int grandparent = nodes[parent].parent;
+    replaceChild(grandparent, parent, sibling);
+    nodes[sibling].parent = grandparent;
+    freeNode(parent);
+    rebalanceUp(grandparent);
+    return true;
+}
+
+template <typename T>
+bool BasicDynamicHull<T>::relabel(T x, T y, int from, int to)
+{
+    const int leaf = findLeaf(x, y);
+    if (leaf < 0) return false;
+    std::vector<int> &ids = nodes[leaf].ids;
+    const auto it = std::find(ids.begin(), ids.end(), from);
+    if (it == ids.end()) return false;
+    *it = to;
+    return true;
+}
+
+template <typename T>
+void BasicDynamicHull<T>::clear()
+{
+    nodes.clear();
+    freeNodes.clear();
+    root = -1;
+    count = 0;
+    tests = 0;
+}
+
+template <typename T>
+void BasicDynamicHull<T>::vertices(std::vector<int> &outHull) const
+{
+    outHull.clear();
+    if (root < 0) return;
+    std::vector<int> lower, upper;
+    collect(root, Lower, -1, -1, lower);
+    collect(root, Upper, -1, -1, upper);
+
+    // both chains run from the smallest to the largest leaf; walk the upper
+    // one back without repeating those two
+    outHull.reserve(lower.size() + upper.size());
+    for (int leaf : lower) outHull.push_back(nodes[leaf].ids.front());
+    for (int i = int(upper.size()) - 2; i > 0; --i) outHull.push_back(nodes[upper[i]].ids.front());
+}
+
+template <typename T>
+int BasicDynamicHull<T>::findLeaf(T x, T y) const
+{
+    if (root < 0) return -1;
+    int v = root;
+    while (!isLeaf(v))
+        v = lexLess(nodes[v].x, nodes[v].y, x, y) ? nodes[v].right : nodes[v].left;
+    return nodes[v].x == x && nodes[v].y == y ? v : -1;
+}
+
+// orientation of the leaves a, b, c, flipped for the lower hull so that a
+// positive result always means c lies outside the chain edge a -> b
+template <typename T>
+int BasicDynamicHull<T>::turn(int side, int a, int b, int c) const
+{
+    ++tests;
+    const int o = orientation(nodes[a].x, nodes[a].y, nodes[b].x, nodes[b].y, nodes[c].x, nodes[c].y);
+    return side == Upper ? o : -o;
+}
+
+template <typename T>
+int BasicDynamicHull<T>::newNode()
+{
+    if (freeNodes.empty()) {
+        nodes.emplace_back();
+        return int(nodes.size()) - 1;
+    }
+    const int v = freeNodes.back();
+    freeNodes.pop_back();
+    nodes[v] = Node();
+    return v;
+}
+
+template <typename T>
+void BasicDynamicHull<T>::freeNode(int v)
+{
+    nodes[v].ids.clear();
+    freeNodes.push_back(v);
+}
+
+template <typename T>
+void BasicDynamicHull<T>::replaceChild(int parent, int from, int to)
+{
+    if (parent < 0) {
+        root = to;
+    } else if (nodes[parent].left == from) {
+        nodes[parent].left = to;
+    } else {
+        nodes[parent].right = to;
+    }
+    nodes[to].parent = parent;
+}
+
+// rotations keep every node's routing key valid: a key only has to separate
+// the node's left subtree from its right one, and both rotations preserve
+// that for the two nodes involved
+template <typename T>
+int BasicDynamicHull<T>::rotateLeft(int v)
+{
+    const int r = nodes[v].right;
+    const int middle = nodes[r].left;
+    replaceChild(nodes[v].parent, v, r);
+    nodes[v].right = middle;
+    nodes[middle].parent = v;
+    nodes[r].left = v;
+    nodes[v].parent = r;
+    updateNode(v);
+    updateNode(r);
+    return r;
+}
+
+template <typename T>
+int BasicDynamicHull<T>::rotateRight(int v)
+{
+    const int l = nodes[v].left;
+    const int middle = nodes[l].right;
+    replaceChild(nodes[v].parent, v, l);
+    nodes[v].left = middle;
+    nodes[middle].parent = v;
+    nodes[l].right = v;
+    nodes[v].parent = l;
+    updateNode(v);
+    updateNode(l);
+    return l;
+}
+
+// restores AVL balance and the bridges from v to the root
+template <typename T>
+void BasicDynamicHull<T>::rebalanceUp(int v)
+{
+    while (v >= 0) {
+        const int l = nodes[v].left;
+        const int r = nodes[v].right;
+        const int balance = height(l) - height(r);
+        if (balance > 1) {
+            if (height(nodes[l].left) < height(nodes[l].right)) rotateLeft(l);
+            v = rotateRight(v);
+        } else if (balance < -1) {
+            if (height(nodes[r].right) < height(nodes[r].left)) rotateRight(r);
+            v = rotateLeft(v);
+        } else {
+            updateNode(v);
+        }
+        v = nodes[v].parent;
+    }
+}
+
+template <typename T>
+void BasicDynamicHull<T>::updateNode(int v)
+{
+    nodes[v].height = 1 + std::max(height(nodes[v].left), height(nodes[v].right));
+    findBridge(v, Upper);
+    findBridge(v, Lower);
+}
+
+// Tangent from leaf q, which lies after every point of subtree v, to the
+// side's hull of v: the vertex where the chain stops turning away from q.
+// The bridge of each node on the way says which child holds it. On ties the
+// vertex farther from q wins, so collinear points never become vertices.
+template <typename T>
+int BasicDynamicHull<T>::tangent(int v, int side, int q) const
+{
+    while (!isLeaf(v)) {
+        const int *b = nodes[v].bridge[side];
+        v = turn(side, b[0], b[1], q) < 0 ? nodes[v].right : nodes[v].left;
+    }
+    return v;
+}
+
+// Bridge of inner node v. The right end is found by descending the right
+// subtree: at node w with bridge (cl, cr), an edge of w's hull, the bridge
+// ends at cr or later exactly when cr is not inside the line from cl's
+// tangent point on the left hull through cl. The left end is then the
+// tangent from the right end.
+template <typename T>
+void BasicDynamicHull<T>::findBridge(int v, int side)
+{
+    const int left = nodes[v].left;
+    int w = nodes[v].right;
+    while (!isLeaf(w)) {
+        const int cl = nodes[w].bridge[side][0];
+        const int cr = nodes[w].bridge[side][1];
+        const int a = tangent(left, side, cl);
+        w = turn(side, a, cl, cr) >= 0 ? nodes[w].right : nodes[w].left;
+    }
+    nodes[v].bridge[side][0] = tangent(left, side, w);
+    nodes[v].bridge[side][1] = w;
+}
+
+// Appends the leaves of subtree v's hull on the given side that lie in
+// [lo, hi] (leaves, -1 for open), left to right. The part left of the
+// bridge comes from the left child, the rest from the right child, and
+// ranges that can't hold a vertex are cut off without descending.
+template <typename T>
+void BasicDynamicHull<T>::collect(int v, int side, int lo, int hi, std::vector<int> &out) const
+{
+    auto before = [&](int a, int b) { return lexLess(nodes[a].x, nodes[a].y, nodes[b].x, nodes[b].y); };
+    if (isLeaf(v)) {
+        if ((lo < 0 || !before(v, lo)) && (hi < 0 || !before(hi, v))) out.push_back(v);
+        return;
+    }
+    const int bl = nodes[v].bridge[side][0];
+    const int br = nodes[v].bridge[side][1];
+    const int leftHi = hi < 0 || before(bl, hi) ? bl : hi;
+    if (lo < 0 || !before(leftHi, lo)) collect(nodes[v].left, side, lo, leftHi, out);
+    const int rightLo = lo < 0 || before(lo, br) ? br : lo;
+    if (hi < 0 || !before(hi, rightLo)) collect(nodes[v].right, side, rightLo, hi, out);
+}
+
+template class BasicDynamicHull<std::int32_t>;
+#ifdef HULL_HAVE_INT128
+template class BasicDynamicHull<std::int64_t>;
+#endif
+template class BasicDynamicHull<float>;
+template class BasicDynamicHull<double>;
+
+} // namespace hull
@@ -0,0 +1,96 @@
+#ifndef HULL_DYNAMICHULL_H
+#define HULL_DYNAMICHULL_H
+
+#include "geometry.h"
+#include <cstdint>
+#include <vector>
+
+namespace hull {
+
+// Fully dynamic convex hull after Overmars and van Leeuwen: points live in
+// the leaves of an AVL tree ordered by (x, y), and every inner node stores
+// the bridges, i.e. the upper and lower hull edge joining the hulls of its
+// two subtrees. The hull of a subtree is never stored; it is the left
+// child's hull up to the bridge followed by the right child's hull from the
+// bridge on, so every query walks the tree instead of a vertex list.
+//
+// A bridge is found by descending the right subtree and asking, at each step,
+// for the tangent from one point to the left subtree's hull, itself one
+// descent. That makes an update O(log^3 n) (O(log n) nodes on the path, each
+// bridge O(log^2 n)) instead of OvL's O(log^2 n) with concatenable queues,
+// but needs no per-node vertex lists. vertices() is O(h log n) for h hull
+// vertices.
+//
+// Points are identified by the caller's id (typically an index into a
+// PointStore) together with their coordinates. Duplicate coordinates share a
+// leaf; the hull reports the oldest id at that position. Collinear boundary
+// points are not vertices, matching computeMonotoneChain.
+template <typename T>
+class BasicDynamicHull
+{
+public:
+    void insert(T x, T y, int id);
+    // false when no point with these coordinates and id is stored
+    bool remove(T x, T y, int id);
+    // gives the point (x, y, from) the id to, e.g. after the caller moved it
+    bool relabel(T x, T y, int from, int to);
+    void clear();
+
+    // number of points stored, duplicates included
+    std::size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+
+    // orientation tests done so far, comparable to the engines' iterations
+    std::int64_t iterations() const { return tests; }
+
+    // ids of the hull vertices counter-clockwise from the leftmost (then
+    // lowest) point, the same order computeMonotoneChain produces
+    void vertices(std::vector<int> &outHull) const;
+
+private:
+    enum Side { Upper = 0, Lower = 1 };
+
+    struct Node
+    {
+        int left = -1;   // inner nodes only; leaves have no children
+        int right = -1;
+        int parent = -1;
+        int height = 1;
+        // leaf: the point; inner node: the largest point of the left subtree
+        T x{};
+        T y{};
+        // inner nodes: bridge[side] = {leaf in left subtree, leaf in right subtree}
+        int bridge[2][2] = {{-1, -1}, {-1, -1}};
+        // leaf: ids of every point at (x, y), oldest first
+        std::vector<int> ids;
+    };
+
+    bool isLeaf(int v) const { return nodes[v].left < 0; }
+    int height(int v) const { return v < 0 ? 0 : nodes[v].height; }
+    int findLeaf(T x, T y) const;
+    int turn(int side, int a, int b, int c) const;
+
+    int newNode();
+    void freeNode(int v);
+    void replaceChild(int parent, int from, int to);
+    int rotateLeft(int v);
+    int rotateRight(int v);
+    void rebalanceUp(int v);
+    void updateNode(int v);
+
+    int tangent(int v, int side, int q) const;
+    void findBridge(int v, int side);
+    void collect(int v, int side, int lo, int hi, std::vector<int> &out) const;
+
+    std::vector<Node> nodes;
+    std::vector<int> freeNodes;
+    int root = -1;
+    std::size_t count = 0;
+    mutable std::int64_t tests = 0;
+};
+
+using DynamicHull = BasicDynamicHull<double>;
+
+} // namespace hull
+
+#endif // HULL_DYNAMICHULL_H
@@ -0,0 +1,208 @@
+#include "generator.h"
+#include "taskpool.h"
+#include "trace.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <type_traits>
+
+namespace hull {
+
+namespace {
+
+constexpr double pi = 3.14159265358979323846;
+// points per block; blocks are the unit of both seeding and tasks
+constexpr std::size_t blockSize = std::size_t(1) << 16;
+
+// SplitMix64: one add and a few multiplies per number, and seeds that differ
+// in one bit give unrelated streams
+struct SplitMix64
+{
+    std::uint64_t state;
+
+    std::uint64_t next()
+    {
+        std::uint64_t z = (state += 0x9e3779b97f4a7c15ull);
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+        return z ^ (z >> 31);
+    }
+    // uniform in [0, 1)
+    double uniform() { return double(next() >> 11) * 0x1p-53; }
+    // two independent standard normals (Box-Muller)
+    void normalPair(double &a, double &b)
+    {
+        const double r = std::sqrt(-2 * std::log1p(-uniform()));
+        const double t = 2 * pi * uniform();
+        a = r * std::cos(t);
+        b = r * std::sin(t);
+    }
+};
+
+std::uint64_t mixSeed(std::uint64_t seed, std::uint64_t stream)
+{
+    SplitMix64 m{seed ^ (stream * 0xd1b54a32d192ed03ull)};
+    return m.next();
+}
+
+// cluster centres shared by all blocks, so they depend on the seed only
+struct Centres
+{
+    double c[16][2];
+};
+
+Centres clusterCentres(std::uint64_t seed)
+{
+    SplitMix64 rng{mixSeed(seed, ~std::uint64_t(0))};
+    Centres centres;
+    for (auto &c : centres.c) {
+        c[0] = 0.1 + 0.8 * rng.uniform();
+        c[1] = 0.1 + 0.8 * rng.uniform();
+    }
+    return centres;
+}
+
+// count unit-square points into u and v, continuing rng's stream
+void generateBlock(Distribution distribution, SplitMix64 &rng, const Centres &centres,
+                   std::size_t count, double *u, double *v)
+{
+    switch (distribution) {
+    case Distribution::UniformSquare:
+        for (std::size_t i = 0; i < count; ++i) {
+            u[i] = rng.uniform();
+            v[i] = rng.uniform();
+        }
+        break;
+    case Distribution::UniformDisk:
+        // rejection from the square: no transcendental functions and 79%
+        // of the draws are kept
+        for (std::size_t i = 0; i < count; ++i) {
+            double a, b;
+            do {
+                a = 2 * rng.uniform() - 1;
+                b = 2 * rng.uniform() - 1;
+            } while (a * a + b * b > 1);
+            u[i] = 0.5 + 0.5 * a;
+            v[i] = 0.5 + 0.5 * b;
+        }
+        break;
+    case Distribution::OnCircle:
+        for (std::size_t i = 0; i < count; ++i) {
+            const double t = 2 * pi * rng.uniform();
+            u[i] = 0.5 + 0.5 * std::cos(t);
+            v[i] = 0.5 + 0.5 * std::sin(t);
+        }
+        break;
+    case Distribution::Gaussian:
+        for (std::size_t i = 0; i < count; ++i) {
+            double a, b;
+            rng.normalPair(a, b);
+            u[i] = 0.5 + a / 6;
+            v[i] = 0.5 + b / 6;
+        }
+        break;
+    case Distribution::Clustered:
+        for (std::size_t i = 0; i < count; ++i) {
+            const double *c = centres.c[rng.next() >> 60];
+            double a, b;
+            rng.normalPair(a, b);
+            u[i] = c[0] + a / 100;
+            v[i] = c[1] + b / 100;
+        }
+        break;
+    case Distribution::NearCollinear:
+        for (std::size_t i = 0; i < count; ++i) {
+            const double t = rng.uniform();
+            u[i] = t;
+            v[i] = 0.25 + 0.5 * t + 2e-9 * (rng.uniform() - 0.5);
+        }
+        break;
+    }
+}
+
+// integers are clamped to the range CoordTraits keeps exact, as bounds
+// near it or the normal tails could land outside; the double bound may
+// round up, so the rounded value is clamped once more
+template <typename T>
+T toCoordinate(double value)
+{
+    if constexpr (std::is_floating_point_v<T>) {
+        return T(value);
+    } else {
+        const long long limit = CoordTraits<T>::limit;
+        const long long rounded = std::llround(std::clamp(value, -double(limit), double(limit)));
+        return T(std::clamp(rounded, -limit, limit));
+    }
+}
+
+} // namespace
+
+const char *distributionName(Distribution distribution)
+{
+    switch (distribution) {
+    case Distribution::UniformSquare: return "uniform-square";
+    case Distribution::UniformDisk: return "uniform-disk";
+    case Distribution::OnCircle: return "on-circle";
+    case Distribution::Gaussian: return "gaussian";
+    case Distribution::Clustered: return "clustered";
+    case Distribution::NearCollinear: return "near-collinear";
+    }
+    return "";
+}
+
+bool parseDistribution(const char *name, Distribution &distribution)
+{
+    for (int d = 0; d < distributionCount; ++d) {
+        if (std::strcmp(name, distributionName(Distribution(d))) == 0) {
+            distribution = Distribution(d);
+            return true;
+        }
+    }
+    return false;
+}
+
+template <typename T>
+void generatePoints(Distribution distribution, std::uint64_t seed, std::size_t n, T *x, T *y,
+                    const GenerateBounds &bounds)
+{
+    TraceSpan span(distributionName(distribution), "generate");
+    const Centres centres = clusterCentres(seed);
+    auto block = [&](std::size_t b) {
+        const std::size_t first = b * blockSize;
+        const std::size_t count = std::min(blockSize, n - first);
+        SplitMix64 rng{mixSeed(seed, b)};
+        // unit-square doubles first, a stack buffer at a time, so every
+        // coordinate type sees the same cloud
+        constexpr std::size_t chunk = 512;
+        double u[chunk], v[chunk];
+        for (std::size_t done = 0; done < count; done += chunk) {
+            const std::size_t m = std::min(chunk, count - done);
+            generateBlock(distribution, rng, centres, m, u, v);
+            T *bx = x + first + done;
+            T *by = y + first + done;
+            for (std::size_t i = 0; i < m; ++i) {
+                bx[i] = toCoordinate<T>(bounds.x + u[i] * bounds.width);
+                by[i] = toCoordinate<T>(bounds.y + v[i] * bounds.height);
+            }
+        }
+    };
+
+    const std::size_t blocks = (n + blockSize - 1) / blockSize;
+    TaskGroup group;
+    for (std::size_t b = 1; b < blocks; ++b) group.run([&block, b] { block(b); });
+    if (blocks > 0) block(0);
+    group.wait();
+}
+
+template void generatePoints<std::int32_t>(Distribution, std::uint64_t, std::size_t, std::int32_t *,
+                                           std::int32_t *, const GenerateBounds &);
+#ifdef HULL_HAVE_INT128
+template void generatePoints<std::int64_t>(Distribution, std::uint64_t, std::size_t, std::int64_t *,
+                                           std::int64_t *, const GenerateBounds &);
+#endif
+template void generatePoints<float>(Distribution, std::uint64_t, std::size_t, float *, float *,
+                                    const GenerateBounds &);
+template void generatePoints<double>(Distribution, std::uint64_t, std::size_t, double *, double *,
+                                     const GenerateBounds &);
+
+} // namespace hull
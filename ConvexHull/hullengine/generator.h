@@ -0,0 +1,67 @@
+#ifndef HULL_GENERATOR_H
+#define HULL_GENERATOR_H
+
+#include "pointstore.h"
+#include <cstddef>
+#include <cstdint>
+
+namespace hull {
+
+// Named synthetic point clouds, defined on the unit square and mapped into
+// GenerateBounds:
+//   UniformSquare  uniform over the square
+//   UniformDisk    uniform over the inscribed disk
+//   OnCircle       on the inscribed circle, so (up to rounding) every point
+//                  is a hull vertex
+//   Gaussian       normal around the centre, sigma 1/6 of the side
+//   Clustered      16 tight normal blobs (sigma 1/100) at seeded centres
+//   NearCollinear  a band of width 2e-9 along a line across the square, so
+//                  orientation tests sit next to zero
+enum class Distribution
+{
+    UniformSquare,
+    UniformDisk,
+    OnCircle,
+    Gaussian,
+    Clustered,
+    NearCollinear
+};
+
+constexpr int distributionCount = 6;
+
+// lower-case name, e.g. "uniform-square", as used by the CLI and benchmark
+const char *distributionName(Distribution distribution);
+// inverse of distributionName; false for unknown names
+bool parseDistribution(const char *name, Distribution &distribution);
+
+// rectangle the unit square is mapped to
+struct GenerateBounds
+{
+    double x = 0;
+    double y = 0;
+    double width = 1;
+    double height = 1;
+};
+
+// Writes n points of the distribution to x and y. The points are cut into
+// fixed blocks, each drawn from its own SplitMix64 stream seeded with
+// (seed, block), and blocks run as tasks on TaskPool::global(); the output
+// depends only on the arguments, never on the thread count. Integer
+// coordinate types get the rounded values, clamped to the exact range of
+// CoordTraits.
+template <typename T>
+void generatePoints(Distribution distribution, std::uint64_t seed, std::size_t n, T *x, T *y,
+                    const GenerateBounds &bounds = GenerateBounds());
+
+// resizes points to n and fills it
+template <typename T>
+void generatePoints(Distribution distribution, std::uint64_t seed, std::size_t n,
+                    BasicPointStore<T> &points, const GenerateBounds &bounds = GenerateBounds())
+{
+    points.resize(n);
+    generatePoints(distribution, seed, n, points.xs(), points.ys(), bounds);
+}
+
+} // namespace hull
+
+#endif // HULL_GENERATOR_H
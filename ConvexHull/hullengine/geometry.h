@@ -0,0 +1,105 @@
+#ifndef HULL_GEOMETRY_H
+#define HULL_GEOMETRY_H
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace hull {
+
+// Coordinate types the engines are instantiated for, with the type their
+// cross products are evaluated in. Integer cross products are exact as long
+// as coordinate differences stay in range: |coordinate| < 2^30 for int32
+// (products fit int64) and < 2^62 for int64 (products fit int128). Floating
+// coordinates go through the adaptive double predicate, float exactly since
+// every float is a double. limit is the largest magnitude an integer
+// coordinate may have; the engines assert it in debug builds.
+template <typename T>
+struct CoordTraits;
+
+template <>
+struct CoordTraits<std::int32_t>
+{
+    using Wide = std::int64_t;
+    static constexpr std::int32_t limit = (std::int32_t(1) << 30) - 1;
+};
+
+#ifdef __SIZEOF_INT128__
+#define HULL_HAVE_INT128 1
+template <>
+struct CoordTraits<std::int64_t>
+{
+    using Wide = __int128;
+    static constexpr std::int64_t limit = (std::int64_t(1) << 62) - 1;
+};
+#endif
+
+template <>
+struct CoordTraits<float>
+{
+    using Wide = double;
+};
+
+template <>
+struct CoordTraits<double>
+{
+    using Wide = double;
+};
+
+template <typename T>
+struct BasicPoint
+{
+    T x;
+    T y;
+};
+
+// non-owning view over points kept as separate x and y arrays (see
+// PointStore); hot loops index x and y directly, everything else can use []
+template <typename T>
+struct BasicPointsView
+{
+    const T *x = nullptr;
+    const T *y = nullptr;
+    std::size_t size = 0;
+
+    BasicPoint<T> operator[](std::size_t i) const { return {x[i], y[i]}; }
+    BasicPointsView slice(std::size_t begin, std::size_t count) const { return {x + begin, y + begin, count}; }
+};
+
+// true when an integer point lies within CoordTraits<T>::limit, always for
+// floating types
+template <typename T>
+bool inExactRange([[maybe_unused]] T x, [[maybe_unused]] T y)
+{
+    if constexpr (std::is_integral_v<T>) {
+        constexpr T limit = CoordTraits<T>::limit;
+        return x >= -limit && x <= limit && y >= -limit && y <= limit;
+    } else {
+        return true;
+    }
+}
+
+template <typename T>
+bool inExactRange(BasicPointsView<T> points)
+{
+    if constexpr (std::is_integral_v<T>) {
+        for (std::size_t i = 0; i < points.size; ++i) {
+            if (!inExactRange(points.x[i], points.y[i])) return false;
+        }
+    }
+    return true;
+}
+
+using Point = BasicPoint<double>;
+using PointsView = BasicPointsView<double>;
+
+// cross product of (a - o) and (b - o) in plain double; > 0 means o->a->b
+// turns left. Use orientation() from predicates.h where the sign matters.
+inline double cross(const Point &o, const Point &a, const Point &b)
+{
+    return (a.x - o.x) * (b.y - o.y) - (a.y - o.y) * (b.x - o.x);
+}
+
+} // namespace hull
+
+#endif // HULL_GEOMETRY_H
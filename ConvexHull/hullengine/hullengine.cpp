@@ -0,0 +1,1188 @@
+#include "hullengine.h"
+#include "orientkernel.h"
+#include "predicates.h"
+#include "taskpool.h"
+#include "trace.h"
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <memory_resource>
+#include <type_traits>
+
+namespace hull {
+
+const char *referenceName(Reference reference)
+{
+    switch (reference) {
+    case Reference::BruteForce: return "brute";
+    case Reference::GiftWrapping: return "gift wrapping";
+    }
+    return "";
+}
+
+const char *algorithmName(Algorithm algorithm)
+{
+    switch (algorithm) {
+    case Algorithm::GrahamScan: return "Graham";
+    case Algorithm::MonotoneChain: return "Monotone chain";
+    case Algorithm::ParallelGraham: return "Parallel Graham";
+    case Algorithm::Chan: return "Chan";
+    case Algorithm::QuickHull: return "QuickHull";
+    }
+    return "";
+}
+
+template <typename T>
+void computeHull(Algorithm algorithm, BasicPointsView<T> points, std::int64_t &iterations,
+                 std::vector<int> &outHull, RunControl *control, const HullOptions &options)
+{
+    TraceSpan span(algorithmName(algorithm), "engine");
+    switch (algorithm) {
+    case Algorithm::GrahamScan:
+        computeGrahamScan(points, iterations, outHull, control, options);
+        break;
+    case Algorithm::MonotoneChain:
+        computeMonotoneChain(points, iterations, outHull, control, options);
+        break;
+    case Algorithm::ParallelGraham:
+        computeParallelHull(points, iterations, outHull, control, 0, options);
+        break;
+    case Algorithm::Chan:
+        computeChan(points, iterations, outHull, control, options);
+        break;
+    case Algorithm::QuickHull:
+        computeQuickHull(points, iterations, outHull, control, options);
+        break;
+    }
+}
+
+template <typename T>
+void computeReference(Reference reference, BasicPointsView<T> points, std::int64_t &iterations,
+                      std::vector<int> &outHull, RunControl *control, const HullOptions &options)
+{
+    TraceSpan span(referenceName(reference), "engine");
+    switch (reference) {
+    case Reference::BruteForce:
+        computeSlowConvexHull(points, iterations, outHull, control, options);
+        break;
+    case Reference::GiftWrapping:
+        computeGiftWrapping(points, iterations, outHull, control, options);
+        break;
+    }
+}
+
+// Counting policies the engines are templates over. ExactCount sums the
+// work it is handed; NoCount's add() is empty, so the compiler drops the
+// counting from the comparators and inner loops altogether. withCounter()
+// picks one per run from options.countIterations; with
+// HULL_NO_ITERATION_COUNTS defined only NoCount is ever instantiated.
+struct ExactCount
+{
+    static constexpr bool enabled = true;
+    std::int64_t count = 0;
+
+    void add(std::int64_t n = 1) { count += n; }
+    std::int64_t value() const { return count; }
+};
+
+struct NoCount
+{
+    static constexpr bool enabled = false;
+
+    void add(std::int64_t = 1) {}
+    std::int64_t value() const { return 0; }
+};
+
+// runs engine(counter) with the policy options ask for and stores the count
+// in iterations
+template <typename Engine>
+static void withCounter(std::int64_t &iterations, [[maybe_unused]] const HullOptions &options, Engine engine)
+{
+#ifndef HULL_NO_ITERATION_COUNTS
+    if (options.countIterations) {
+        ExactCount counter;
+        engine(counter);
+        iterations = counter.value();
+        return;
+    }
+#endif
+    NoCount counter;
+    engine(counter);
+    iterations = 0;
+}
+
+// LSD radix sort of keys, carrying order along, 8 bits per pass. Passes
+// where every key has the same digit are skipped; returns the number of
+// passes made.
+static int radixSort(std::pmr::vector<std::uint64_t> &keys, std::pmr::vector<int> &order)
+{
+    const std::size_t n = keys.size();
+    std::pmr::memory_resource *scratch = keys.get_allocator().resource();
+    std::pmr::vector<std::uint64_t> keysTmp(n, scratch);
+    std::pmr::vector<int> orderTmp(n, scratch);
+    // all eight histograms in one read of the keys
+    std::pmr::vector<std::size_t> counts(8 * 256, 0, scratch);
+    for (std::uint64_t key : keys)
+        for (int d = 0; d < 8; ++d) ++counts[d * 256 + ((key >> (8 * d)) & 0xff)];
+
+    int passes = 0;
+    for (int d = 0; d < 8; ++d) {
+        std::size_t *count = counts.data() + d * 256;
+        if (std::find(count, count + 256, n) != count + 256) continue;
+        std::size_t offset = 0;
+        for (int b = 0; b < 256; ++b) {
+            const std::size_t c = count[b];
+            count[b] = offset;
+            offset += c;
+        }
+        for (std::size_t i = 0; i < n; ++i) {
+            const std::size_t to = count[(keys[i] >> (8 * d)) & 0xff]++;
+            keysTmp[to] = keys[i];
+            orderTmp[to] = order[i];
+        }
+        keys.swap(keysTmp);
+        order.swap(orderTmp);
+        ++passes;
+    }
+    return passes;
+}
+
+// Sorts [first, last) with less(a, b, comparisons) on the pool: one chunk
+// per pool thread is std::sorted as a task, then chunks are merged pairwise
+// in rounds, each merge split into independent pieces at matching
+// positions of its two halves (found by binary search) so that even the
+// last round keeps every thread busy. less counts its comparisons in the
+// counter it is handed, one per task, and the totals are added to
+// comparisons. The merge buffer comes from scratch.
+template <typename Less, typename Counter>
+static void parallelSort(int *first, int *last, Less less, Counter &comparisons, TaskPool &pool,
+                         std::pmr::memory_resource *scratch)
+{
+    const int n = static_cast<int>(last - first);
+    const int threads = pool.threadCount();
+    // below this a chunk isn't worth a task
+    const int minChunk = 1 << 12;
+    const int chunks = std::max(1, std::min(threads, n / minChunk));
+    if (chunks == 1) {
+        std::sort(first, last, [&](int a, int b) { return less(a, b, comparisons); });
+        return;
+    }
+
+    std::pmr::vector<int> bounds(chunks + 1, scratch);
+    for (int c = 0; c <= chunks; ++c) bounds[c] = int(std::int64_t(n) * c / chunks);
+    std::atomic<std::int64_t> total{0};
+    auto sortRange = [&](int *begin, int *end) {
+        Counter local;
+        std::sort(begin, end, [&](int a, int b) { return less(a, b, local); });
+        if constexpr (Counter::enabled) total.fetch_add(local.value(), std::memory_order_relaxed);
+    };
+    {
+        TaskGroup group(pool);
+        for (int c = 1; c < chunks; ++c)
+            group.run([&, c] { sortRange(first + bounds[c], first + bounds[c + 1]); });
+        sortRange(first + bounds[0], first + bounds[1]);
+        group.wait();
+    }
+
+    std::pmr::vector<int> buffer(n, scratch);
+    int *from = first;
+    int *to = buffer.data();
+    for (int width = 1; width < chunks; width *= 2) {
+        const int merges = (chunks + 2 * width - 1) / (2 * width);
+        const int pieces = std::max(1, threads / merges);
+        TaskGroup group(pool);
+        for (int c = 0; c < chunks; c += 2 * width) {
+            const int begin = bounds[c];
+            const int middle = bounds[std::min(c + width, chunks)];
+            const int end = bounds[std::min(c + 2 * width, chunks)];
+            for (int piece = 0; piece < pieces; ++piece) {
+                group.run([&, begin, middle, end, piece] {
+                    Counter local;
+                    auto counted = [&](int a, int b) { return less(a, b, local); };
+                    // this piece takes a slice of the left half and the part
+                    // of the right half that sorts before the next slice
+                    const int leftSize = middle - begin;
+                    const int a0 = begin + int(std::int64_t(leftSize) * piece / pieces);
+                    const int a1 = begin + int(std::int64_t(leftSize) * (piece + 1) / pieces);
+                    const int b0 = piece == 0 ? middle
+                        : int(std::lower_bound(from + middle, from + end, from[a0], counted) - from);
+                    const int b1 = piece + 1 == pieces ? end
+                        : int(std::lower_bound(from + middle, from + end, from[a1], counted) - from);
+                    std::merge(from + a0, from + a1, from + b0, from + b1,
+                               to + a0 + (b0 - middle), counted);
+                    if constexpr (Counter::enabled) total.fetch_add(local.value(), std::memory_order_relaxed);
+                });
+            }
+        }
+        group.wait();
+        std::swap(from, to);
+    }
+    if (from != first) std::copy(from, from + n, first);
+    comparisons.add(total.load());
+}
+
+// Graham scan (fast) implementation. iterations counts comparisons and cross ops roughly.
+// Hull is any vector of int, so the parallel hull can keep its chunk hulls
+// in scratch memory too.
+template <typename T, typename Hull, typename Counter>
+static void grahamScan(BasicPointsView<T> points, Counter &iterations, Hull &outHull,
+                       RunControl *control, const HullOptions &options)
+{
+    assert(inExactRange(points));
+    outHull.clear();
+    int n = static_cast<int>(points.size);
+    if (n == 0) return;
+    const T *px = points.x;
+    const T *py = points.y;
+    std::pmr::memory_resource *scratch = scratchResource(options.arena);
+    // create indices
+    std::pmr::vector<int> idx(n, scratch);
+    for (int i = 0; i < n; ++i) idx[i] = i;
+
+    // find pivot = lowest y (and lowest x if tie)
+    PhaseTimer pivotTimer(options.profile, Phase::PivotSearch);
+    int pivot = 0;
+    for (int i = 1; i < n; ++i) {
+        iterations.add();
+        if (py[i] < py[pivot] || (py[i] == py[pivot] && px[i] < px[pivot]))
+            pivot = i;
+    }
+    pivotTimer.stop();
+    if (control) {
+        if (control->isCancelled()) return;
+        control->report(0.1);
+    }
+
+    const BasicPoint<T> p0 = points[pivot];
+    // a strictly closer to p0 than b, for a and b on the same ray from p0;
+    // compares raw coordinates so no rounded distance can tie or flip. A
+    // vertical ray always points up since p0 is the lowest point.
+    auto closer = [&](int a, int b) {
+        if (px[a] != px[b]) return (px[a] < px[b]) == (px[b] > p0.x);
+        return py[a] < py[b];
+    };
+    // copies of the pivot have no angle; move them all to the front once so
+    // the comparator never has to check for them
+    auto atPivot = [&](int i) { return px[i] == p0.x && py[i] == p0.y; };
+    PhaseTimer sortTimer(options.profile, Phase::AngularSort);
+    const auto rest = std::partition(idx.begin(), idx.end(), atPivot);
+    // sort by angle wrt pivot, ties by distance; counts into its own
+    // counter so the parallel sort can hand every task one
+    auto angleOrder = [&](int a, int b, auto &comparisons){
+        comparisons.add();
+        const int o = orientation(p0.x, p0.y, px[a], py[a], px[b], py[b]);
+        if (o == 0) {
+            // collinear: closer one first
+            return closer(a, b);
+        }
+        return o > 0; // a before b if left of b (i.e. smaller angle)
+    };
+    auto angleLess = [&](int a, int b) { return angleOrder(a, b, iterations); };
+    auto sortByAngle = [&]() {
+        if (std::size_t(idx.end() - rest) >= options.parallelSortThreshold)
+            parallelSort(idx.data() + (rest - idx.begin()), idx.data() + n, angleOrder, iterations,
+                         options.pool ? *options.pool : TaskPool::global(), scratch);
+        else
+            std::sort(rest, idx.end(), angleLess);
+    };
+    if (options.angularSort == AngularSort::Radix) {
+        // high half: pseudo-angle 1 - dx / (|dx| + dy), monotone in the angle
+        // over [0, pi) where all points lie; low half: the float bits of
+        // |dx| + dy, monotone in the distance along a ray
+        const int m = static_cast<int>(idx.end() - rest);
+        std::pmr::vector<std::uint64_t> keys(m, scratch);
+        std::pmr::vector<int> order(rest, idx.end(), scratch);
+        for (int k = 0; k < m; ++k) {
+            const double dx = double(px[order[k]]) - double(p0.x);
+            const double dy = double(py[order[k]]) - double(p0.y);
+            const double l1 = std::abs(dx) + dy;
+            const double angle = std::min((1.0 - dx / l1) * 0x1p31, 0x1p32 - 1);
+            const float distance = static_cast<float>(l1);
+            std::uint32_t distanceBits;
+            std::memcpy(&distanceBits, &distance, sizeof distanceBits);
+            keys[k] = (std::uint64_t(angle) << 32) | distanceBits;
+        }
+        iterations.add(std::int64_t(m) * radixSort(keys, order));
+        std::copy(order.begin(), order.end(), rest);
+
+        // keys are rounded, so neighbours within rounding of each other may
+        // be swapped; insertion sort with the exact comparator repairs that in
+        // linear time. Should an input defeat the keys, std::sort takes over.
+        std::int64_t budget = 8 * std::int64_t(m) + 64;
+        for (auto i = rest; i != idx.end() && budget >= 0; ++i) {
+            const int v = *i;
+            auto j = i;
+            for (; j != rest && angleLess(v, *(j - 1)) && --budget >= 0; --j) *j = *(j - 1);
+            *j = v;
+        }
+        if (budget < 0) sortByAngle();
+    } else {
+        sortByAngle();
+    }
+    sortTimer.stop();
+    if (control) {
+        if (control->isCancelled()) return;
+        control->report(0.8);
+    }
+
+    // remove points with same angle keeping farthest (typical Graham variant)
+    PhaseTimer filterTimer(options.profile, Phase::CollinearFilter);
+    std::pmr::vector<int> filtered(scratch);
+    filtered.reserve(n);
+    for (int i = 0; i < n; ++i) {
+        if (filtered.empty()) { filtered.push_back(idx[i]); continue; }
+        const int b = idx[i];
+        if (filtered.size() == 1) {
+            // the pivot has no angle to compare against; only drop copies of it
+            if (!atPivot(b)) filtered.push_back(b);
+            continue;
+        }
+        // if same angle as previous, keep the farthest
+        const int a = filtered.back();
+        iterations.add();
+        if (orientation(p0.x, p0.y, px[a], py[a], px[b], py[b]) == 0) {
+            // choose farthest
+            if (closer(a, b))
+                filtered.back() = b;
+            // else keep existing
+        } else {
+            filtered.push_back(idx[i]);
+        }
+    }
+
+    filterTimer.stop();
+    if (filtered.size() < 3) {
+        // everything collinear or too small
+        outHull.assign(filtered.begin(), filtered.end());
+        return;
+    }
+
+    // stack
+    PhaseTimer scanTimer(options.profile, Phase::StackScan);
+    Hull &st = outHull;
+    st.reserve(filtered.size());
+    st.push_back(filtered[0]);
+    st.push_back(filtered[1]);
+
+    for (std::size_t i = 2; i < filtered.size(); ++i) {
+        while (st.size() >= 2) {
+            int s1 = st[st.size()-2];
+            int s2 = st[st.size()-1];
+            int s3 = filtered[i];
+            iterations.add();
+            if (orientation(px[s1], py[s1], px[s2], py[s2], px[s3], py[s3]) <= 0) {
+                // non-left turn -> pop (use <= to exclude collinear non-left)
+                st.pop_back();
+            } else {
+                break;
+            }
+        }
+        st.push_back(filtered[i]);
+    }
+    if (control) control->report(1.0);
+}
+
+template <typename T>
+void computeGrahamScan(BasicPointsView<T> points, std::int64_t &iterations, std::vector<int> &outHull,
+                       RunControl *control, const HullOptions &options)
+{
+    withCounter(iterations, options, [&](auto &counter) {
+        grahamScan(points, counter, outHull, control, options);
+    });
+}
+
+// Monotone chain. The sort runs over a contiguous copy of (x, y, index) so the
+// comparator never chases an index back into the input; iterations counts
+// comparisons and cross ops like the Graham scan does. The two stages work
+// on caller-provided buffers so the batch engine can reuse them across sets.
+template <typename T>
+struct ChainEntry
+{
+    T x, y;
+    int index;
+};
+
+// sorts entries[0, n) lexicographically and drops duplicates, which would
+// show up as zero-length edges; returns how many entries are left
+template <typename T, typename Counter>
+static int sortChainEntries(ChainEntry<T> *entries, int n, Counter &iterations)
+{
+    using Entry = ChainEntry<T>;
+    std::sort(entries, entries + n, [&](const Entry &a, const Entry &b){
+        iterations.add();
+        return a.x < b.x || (a.x == b.x && a.y < b.y);
+    });
+    return int(std::unique(entries, entries + n, [](const Entry &a, const Entry &b){
+        return a.x == b.x && a.y == b.y;
+    }) - entries);
+}
+
+// hull of the sorted distinct entries[0, m) as positions into entries,
+// written to st (room for 2m); returns the vertex count
+template <typename T, typename Counter>
+static int chainHull(const ChainEntry<T> *sorted, int m, int *st, Counter &iterations)
+{
+    if (m < 3) {
+        for (int i = 0; i < m; ++i) st[i] = i;
+        return m;
+    }
+    // lower chain left to right, then upper chain back
+    int k = 0;
+    auto turn = [&](int o, int a, int b) {
+        iterations.add();
+        return orientation(sorted[o].x, sorted[o].y, sorted[a].x, sorted[a].y, sorted[b].x, sorted[b].y);
+    };
+    for (int i = 0; i < m; ++i) {
+        while (k >= 2 && turn(st[k-2], st[k-1], i) <= 0) --k;
+        st[k++] = i;
+    }
+    for (int i = m - 2, lower = k + 1; i >= 0; --i) {
+        while (k >= lower && turn(st[k-2], st[k-1], i) <= 0) --k;
+        st[k++] = i;
+    }
+    // the last point repeats the first
+    return k - 1;
+}
+
+// Hull is any vector of int, like for grahamScan.
+template <typename T, typename Hull, typename Counter>
+static void monotoneChain(BasicPointsView<T> points, Counter &iterations, Hull &outHull,
+                          RunControl *control, const HullOptions &options)
+{
+    assert(inExactRange(points));
+    outHull.clear();
+    int n = static_cast<int>(points.size);
+    if (n == 0) return;
+    std::pmr::memory_resource *scratch = scratchResource(options.arena);
+
+    std::pmr::vector<ChainEntry<T>> sorted(n, scratch);
+    for (int i = 0; i < n; ++i) sorted[i] = {points.x[i], points.y[i], i};
+    const int m = sortChainEntries(sorted.data(), n, iterations);
+    if (control) {
+        if (control->isCancelled()) return;
+        control->report(0.8);
+    }
+
+    std::pmr::vector<int> st(2 * m, scratch);
+    const int h = chainHull(sorted.data(), m, st.data(), iterations);
+    outHull.resize(h);
+    for (int i = 0; i < h; ++i) outHull[i] = sorted[st[i]].index;
+    if (control) control->report(1.0);
+}
+
+template <typename T>
+void computeMonotoneChain(BasicPointsView<T> points, std::int64_t &iterations, std::vector<int> &outHull,
+                          RunControl *control, const HullOptions &options)
+{
+    withCounter(iterations, options, [&](auto &counter) {
+        monotoneChain(points, counter, outHull, control, options);
+    });
+}
+
+// Gift wrapping order around hull vertex p: the next vertex is the point
+// every other one is left of, so a beats b if it lies right of p->b, or on it
+// and farther out. Copies of p lose to everything. Two candidates can't be
+// collinear with p on opposite sides of it, as p would then not be a hull
+// vertex.
+template <typename T, typename Counter>
+static bool wrapsBefore(BasicPointsView<T> points, int p, int a, int b, Counter &iterations)
+{
+    const T *px = points.x;
+    const T *py = points.y;
+    auto atP = [&](int i) { return px[i] == px[p] && py[i] == py[p]; };
+    if (atP(b)) return !atP(a);
+    if (atP(a)) return false;
+    iterations.add();
+    const int o = orientation(px[p], py[p], px[b], py[b], px[a], py[a]);
+    if (o != 0) return o < 0;
+    if (px[b] != px[p]) return px[a] != px[b] && (px[a] > px[b]) == (px[b] > px[p]);
+    return py[a] != py[b] && (py[a] > py[b]) == (py[b] > py[p]);
+}
+
+template <typename T, typename Counter>
+static void chan(BasicPointsView<T> points, Counter &iterations, std::vector<int> &outHull,
+                 RunControl *control, const HullOptions &options)
+{
+    assert(inExactRange(points));
+    outHull.clear();
+    const int n = static_cast<int>(points.size);
+    if (n == 0) return;
+    const T *px = points.x;
+    const T *py = points.y;
+
+    // the lowest (then leftmost) point is a hull vertex; wrapping starts there
+    int start = 0;
+    for (int i = 1; i < n; ++i) {
+        iterations.add();
+        if (py[i] < py[start] || (py[i] == py[start] && px[i] < px[start]))
+            start = i;
+    }
+
+    int p = start;
+    auto atP = [&](int i) { return px[i] == px[p] && py[i] == py[p]; };
+    auto better = [&](int a, int b) { return wrapsBefore(points, p, a, b, iterations); };
+
+    // best vertex of one group hull h[0..m) (counter-clockwise) for the
+    // current p. Seen from p, quality rises and then falls once around the
+    // polygon, so a binary search finds the maximum (Sunday's tangent search
+    // over the better() order). If degenerate input makes the search miss,
+    // the group is scanned linearly instead.
+    auto tangent = [&](const int *h, int m) {
+        auto isMax = [&](int c) {
+            return !better(h[(c + 1) % m], h[c]) && !better(h[(c + m - 1) % m], h[c]);
+        };
+        if (m > 3) {
+            if (better(h[0], h[1]) && !better(h[m-1], h[0])) return h[0];
+            int a = 0, b = m;
+            for (int steps = 0; b - a > 1 && steps < 64; ++steps) {
+                const int c = (a + b) / 2;
+                const bool downC = better(h[c], h[(c + 1) % m]);
+                if (downC && !better(h[c-1], h[c])) return h[c];
+                const bool upA = better(h[a+1], h[a]);
+                if (upA) {
+                    if (downC || better(h[a], h[c])) b = c;
+                    else a = c;
+                } else {
+                    if (downC && better(h[c], h[a])) b = c;
+                    else a = c;
+                }
+            }
+            if (isMax(a)) return h[a];
+        }
+        int best = h[0];
+        for (int i = 1; i < m; ++i)
+            if (better(h[i], best)) best = h[i];
+        return best;
+    };
+
+    std::pmr::memory_resource *scratch = scratchResource(options.arena);
+    std::pmr::vector<int> groupHulls(scratch);
+    std::pmr::vector<int> groupBegin(scratch);
+    std::pmr::vector<int> local(scratch);
+    for (int round = 1; ; ++round) {
+        if (control && control->isCancelled()) {
+            outHull.clear();
+            return;
+        }
+        // group size 2^(2^round), capped at n; the last round is one group
+        // and always finishes
+        const int m = round >= 5 ? n : static_cast<int>(std::min<std::int64_t>(n, std::int64_t(1) << (1 << round)));
+
+        groupHulls.clear();
+        groupBegin.clear();
+        for (int begin = 0; begin < n; begin += m) {
+            const int count = std::min(m, n - begin);
+            monotoneChain(points.slice(begin, count), iterations, local, nullptr, options);
+            groupBegin.push_back(static_cast<int>(groupHulls.size()));
+            for (int i : local) groupHulls.push_back(begin + i);
+        }
+        groupBegin.push_back(static_cast<int>(groupHulls.size()));
+        const int groups = static_cast<int>(groupBegin.size()) - 1;
+
+        outHull.clear();
+        p = start;
+        bool closed = false;
+        for (int step = 0; step < m; ++step) {
+            outHull.push_back(p);
+            int next = -1;
+            for (int g = 0; g < groups; ++g) {
+                const int c = tangent(groupHulls.data() + groupBegin[g], groupBegin[g + 1] - groupBegin[g]);
+                if (next < 0 || better(c, next)) next = c;
+            }
+            // back at the start (or a copy of it), or nothing but copies of p
+            if ((px[next] == px[start] && py[next] == py[start]) || atP(next)) {
+                closed = true;
+                break;
+            }
+            p = next;
+        }
+        if (closed) break;
+    }
+    if (control) control->report(1.0);
+}
+
+template <typename T>
+void computeChan(BasicPointsView<T> points, std::int64_t &iterations, std::vector<int> &outHull,
+                 RunControl *control, const HullOptions &options)
+{
+    withCounter(iterations, options, [&](auto &counter) {
+        chan(points, counter, outHull, control, options);
+    });
+}
+
+// QuickHull recursion over idx[first, last), all strictly right of p->q.
+// Leaves the hull vertices strictly between p and q, in order from p to q,
+// at the front of the range and returns how many there are. Tasks count
+// into a Counter of their own and add it to iterations when done.
+template <typename Counter, typename T>
+static int quickHullSide(BasicPointsView<T> points, int p, int q, int *idx, int first, int last,
+                         std::atomic<std::int64_t> &iterations, RunControl *control, TaskPool &pool)
+{
+    if (first == last) return 0;
+    if (control && control->isCancelled()) return 0;
+    const T *px = points.x;
+    const T *py = points.y;
+    Counter work;
+
+    // farthest right of p->q; of several on one parallel the lexicographically
+    // smallest, an end of their segment and so a proper vertex
+    int far = idx[first];
+    for (int i = first + 1; i < last; ++i) {
+        const int c = idx[i];
+        work.add();
+        const int o = compareSideDistance(px[p], py[p], px[q], py[q], px[c], py[c], px[far], py[far]);
+        if (o < 0 || (o == 0 && (px[c] < px[far] || (px[c] == px[far] && py[c] < py[far]))))
+            far = c;
+    }
+
+    // outside p->far first, then outside far->q; nothing can be outside both,
+    // and the rest (far itself included) is inside the triangle or on it
+    auto rightOf = [&](int a, int b) {
+        return [&, a, b](int c) {
+            work.add();
+            return orientation(px[a], py[a], px[b], py[b], px[c], py[c]) < 0;
+        };
+    };
+    int *const begin = idx + first;
+    int *const mid = std::partition(begin, idx + last, rightOf(p, far));
+    int *const end = std::partition(mid, idx + last, rightOf(far, q));
+    if constexpr (Counter::enabled) iterations.fetch_add(work.value(), std::memory_order_relaxed);
+
+    const int split = first + int(mid - begin);
+    const int stop = first + int(end - begin);
+    int countLeft = 0, countRight = 0;
+    // below this a task costs more than the recursion it would offload
+    const int minTask = 1 << 13;
+    if (split - first >= minTask && stop - split >= minTask) {
+        // the task captures one reference so std::function stores it inline
+        auto left = [&] { countLeft = quickHullSide<Counter>(points, p, far, idx, first, split, iterations, control, pool); };
+        TaskGroup group(pool);
+        group.run([&left] { left(); });
+        countRight = quickHullSide<Counter>(points, far, q, idx, split, stop, iterations, control, pool);
+        group.wait();
+    } else {
+        countLeft = quickHullSide<Counter>(points, p, far, idx, first, split, iterations, control, pool);
+        countRight = quickHullSide<Counter>(points, far, q, idx, split, stop, iterations, control, pool);
+    }
+
+    // compact to: left vertices, far, right vertices. far came from the
+    // range and isn't in either part, so the result still fits
+    std::memmove(idx + first + countLeft + 1, idx + split, sizeof(int) * countRight);
+    idx[first + countLeft] = far;
+    return countLeft + 1 + countRight;
+}
+
+template <typename T, typename Counter>
+static void quickHull(BasicPointsView<T> points, Counter &iterations, std::vector<int> &outHull,
+                      RunControl *control, const HullOptions &options)
+{
+    assert(inExactRange(points));
+    outHull.clear();
+    const int n = static_cast<int>(points.size);
+    if (n == 0) return;
+    const T *px = points.x;
+    const T *py = points.y;
+
+    // lexicographic extremes are hull vertices
+    int lo = 0, hi = 0;
+    for (int i = 1; i < n; ++i) {
+        if (px[i] < px[lo] || (px[i] == px[lo] && py[i] < py[lo])) lo = i;
+        if (px[i] > px[hi] || (px[i] == px[hi] && py[i] > py[hi])) hi = i;
+    }
+    iterations.add(n - 1);
+    if (px[lo] == px[hi] && py[lo] == py[hi]) {
+        outHull.push_back(lo);
+        return;
+    }
+
+    // below lo->hi, then above it; points on the line are dropped
+    std::pmr::vector<int> idx(n, scratchResource(options.arena));
+    for (int i = 0; i < n; ++i) idx[i] = i;
+    auto side = [&](int a, int b) {
+        return [&, a, b](int c) { return orientation(px[a], py[a], px[b], py[b], px[c], py[c]) < 0; };
+    };
+    const int below = int(std::partition(idx.begin(), idx.end(), side(lo, hi)) - idx.begin());
+    const int above = int(std::partition(idx.begin() + below, idx.end(), side(hi, lo)) - idx.begin());
+    iterations.add(2 * std::int64_t(n));
+    std::atomic<std::int64_t> work{0};
+    if (control) {
+        if (control->isCancelled()) return;
+        control->report(0.1);
+    }
+
+    TaskPool &pool = options.pool ? *options.pool : TaskPool::global();
+    int countLower = 0, countUpper = 0;
+    {
+        auto lower = [&] { countLower = quickHullSide<Counter>(points, lo, hi, idx.data(), 0, below, work, control, pool); };
+        TaskGroup group(pool);
+        group.run([&lower] { lower(); });
+        countUpper = quickHullSide<Counter>(points, hi, lo, idx.data(), below, above, work, control, pool);
+        group.wait();
+    }
+    iterations.add(work.load());
+    if (control && control->isCancelled()) return;
+
+    outHull.reserve(countLower + countUpper + 2);
+    outHull.push_back(lo);
+    outHull.insert(outHull.end(), idx.begin(), idx.begin() + countLower);
+    outHull.push_back(hi);
+    outHull.insert(outHull.end(), idx.begin() + below, idx.begin() + below + countUpper);
+    if (control) control->report(1.0);
+}
+
+template <typename T>
+void computeQuickHull(BasicPointsView<T> points, std::int64_t &iterations, std::vector<int> &outHull,
+                      RunControl *control, const HullOptions &options)
+{
+    withCounter(iterations, options, [&](auto &counter) {
+        quickHull(points, counter, outHull, control, options);
+    });
+}
+
+template <typename T, typename Counter>
+static void parallelHull(BasicPointsView<T> points, Counter &iterations, std::vector<int> &outHull,
+                         RunControl *control, int threads, const HullOptions &options)
+{
+    assert(inExactRange(points));
+    outHull.clear();
+    const std::size_t n = points.size;
+    if (n == 0) return;
+
+    // below this many points per chunk the task overhead outweighs the work
+    const std::size_t minChunk = 1 << 14;
+    TaskPool &pool = options.pool ? *options.pool : TaskPool::global();
+    std::size_t chunks = threads > 0 ? std::size_t(threads) : std::size_t(pool.threadCount());
+    chunks = std::max<std::size_t>(1, std::min(chunks, n / minChunk));
+    if (chunks == 1) {
+        grahamScan(points, iterations, outHull, control, options);
+        return;
+    }
+
+    // local hulls hold indices into their own chunk
+    std::pmr::memory_resource *scratch = scratchResource(options.arena);
+    std::pmr::vector<std::pmr::vector<int>> local(chunks, scratch);
+    std::pmr::vector<Counter> localIterations(chunks, scratch);
+    auto chunkBegin = [&](std::size_t c) { return n * c / chunks; };
+    // chunks run concurrently, so each records into its own profile
+    std::pmr::vector<RunProfile> localProfiles(options.profile ? chunks : 0, scratch);
+    auto work = [&](std::size_t c) {
+        const std::size_t begin = chunkBegin(c);
+        const BasicPointsView<T> part = points.slice(begin, chunkBegin(c + 1) - begin);
+        HullOptions chunkOptions = options;
+        if (options.profile) chunkOptions.profile = &localProfiles[c];
+        grahamScan(part, localIterations[c], local[c], nullptr, chunkOptions);
+    };
+    {
+        TaskGroup group(pool);
+        for (std::size_t c = 1; c < chunks; ++c) group.run([&work, c] { work(c); });
+        work(0);
+        group.wait();
+    }
+    if (control) {
+        if (control->isCancelled()) return;
+        control->report(0.9);
+    }
+
+    // hull of the hulls: every hull vertex is a vertex of its chunk's hull
+    std::size_t total = 0;
+    for (const auto &hull : local) total += hull.size();
+    std::pmr::vector<T> mergedX(scratch), mergedY(scratch);
+    std::pmr::vector<int> originalIndex(scratch);
+    mergedX.reserve(total);
+    mergedY.reserve(total);
+    originalIndex.reserve(total);
+    for (const RunProfile &profile : localProfiles) options.profile->merge(profile);
+    for (std::size_t c = 0; c < chunks; ++c) {
+        iterations.add(localIterations[c].value());
+        const int begin = static_cast<int>(chunkBegin(c));
+        for (int i : local[c]) {
+            mergedX.push_back(points.x[begin + i]);
+            mergedY.push_back(points.y[begin + i]);
+            originalIndex.push_back(begin + i);
+        }
+    }
+    const BasicPointsView<T> merged{mergedX.data(), mergedY.data(), total};
+    grahamScan(merged, iterations, outHull, nullptr, options);
+    for (int &i : outHull) i = originalIndex[i];
+    if (control) control->report(1.0);
+}
+
+template <typename T>
+void computeParallelHull(BasicPointsView<T> points, std::int64_t &iterations, std::vector<int> &outHull,
+                         RunControl *control, int threads, const HullOptions &options)
+{
+    withCounter(iterations, options, [&](auto &counter) {
+        parallelHull(points, counter, outHull, control, threads, options);
+    });
+}
+
+template <typename T, typename Counter>
+static void hullBatch(BasicPointSets<T> sets, Counter &iterations, HullSets &out,
+                      RunControl *control, const HullOptions &options)
+{
+    assert(inExactRange(sets.points));
+    const std::size_t count = sets.count;
+    const int total = count ? sets.offsets[count] : 0;
+    // out.offsets first holds every hull's size; the indices of hull s start
+    // at sets.offsets[s], which has room since a hull is never bigger than
+    // its set
+    out.offsets.assign(count + 1, 0);
+    out.indices.resize(total);
+    if (count == 0) return;
+
+    TaskPool &pool = options.pool ? *options.pool : TaskPool::global();
+    // a few tasks per thread evens out sets of different cost; runs end at
+    // the first set boundary past their share of the points
+    const int minTaskPoints = 1 << 12;
+    const int tasks = std::max(1, std::min(4 * pool.threadCount(), total / minTaskPoints));
+    std::pmr::memory_resource *scratch = scratchResource(options.arena);
+    std::pmr::vector<std::size_t> taskBegin(tasks + 1, scratch);
+    for (int t = 0; t <= tasks; ++t) {
+        const int target = int(std::int64_t(total) * t / tasks);
+        taskBegin[t] = std::size_t(std::lower_bound(sets.offsets, sets.offsets + count, target) - sets.offsets);
+    }
+    taskBegin[tasks] = count;
+
+    std::atomic<std::int64_t> work{0};
+    std::atomic<int> tasksDone{0};
+    auto hullRun = [&](int t) {
+        const std::size_t first = taskBegin[t];
+        const std::size_t last = taskBegin[t + 1];
+        int largest = 0;
+        for (std::size_t s = first; s < last; ++s)
+            largest = std::max(largest, sets.offsets[s + 1] - sets.offsets[s]);
+        std::pmr::vector<ChainEntry<T>> sorted(largest, scratch);
+        std::pmr::vector<int> st(2 * largest, scratch);
+
+        Counter local;
+        for (std::size_t s = first; s < last; ++s) {
+            if (control && control->isCancelled()) break;
+            const int begin = sets.offsets[s];
+            const int n = sets.offsets[s + 1] - begin;
+            for (int i = 0; i < n; ++i)
+                sorted[i] = {sets.points.x[begin + i], sets.points.y[begin + i], begin + i};
+            const int m = sortChainEntries(sorted.data(), n, local);
+            const int h = chainHull(sorted.data(), m, st.data(), local);
+            int *hull = out.indices.data() + begin;
+            for (int i = 0; i < h; ++i) hull[i] = sorted[st[i]].index;
+            out.offsets[s + 1] = h;
+        }
+        if constexpr (Counter::enabled) work.fetch_add(local.value(), std::memory_order_relaxed);
+        if (control) control->report(0.9 * (tasksDone.fetch_add(1, std::memory_order_relaxed) + 1) / tasks);
+    };
+    {
+        TaskGroup group(pool);
+        for (int t = 1; t < tasks; ++t) group.run([&hullRun, t] { hullRun(t); });
+        hullRun(0);
+        group.wait();
+    }
+    iterations.add(work.load());
+    if (control && control->isCancelled()) {
+        out.offsets.clear();
+        out.indices.clear();
+        return;
+    }
+
+    // sizes to offsets, moving every hull down to its final place; a hull
+    // only ever moves towards the front, past hulls already moved
+    int end = 0;
+    for (std::size_t s = 0; s < count; ++s) {
+        const int h = out.offsets[s + 1];
+        std::memmove(out.indices.data() + end, out.indices.data() + sets.offsets[s], sizeof(int) * h);
+        end += h;
+        out.offsets[s + 1] = end;
+    }
+    out.indices.resize(end);
+    if (control) control->report(1.0);
+}
+
+template <typename T>
+void computeHulls(BasicPointSets<T> sets, std::int64_t &iterations, HullSets &out,
+                  RunControl *control, const HullOptions &options)
+{
+    TraceSpan span("batch", "engine");
+    withCounter(iterations, options, [&](auto &counter) {
+        hullBatch(sets, counter, out, control, options);
+    });
+}
+
+template <typename T, typename Counter>
+static void giftWrapping(BasicPointsView<T> points, Counter &iterations, std::vector<int> &outHull,
+                         RunControl *control)
+{
+    assert(inExactRange(points));
+    outHull.clear();
+    const int n = static_cast<int>(points.size);
+    if (n == 0) return;
+    const T *px = points.x;
+    const T *py = points.y;
+
+    int start = 0;
+    for (int i = 1; i < n; ++i) {
+        iterations.add();
+        if (py[i] < py[start] || (py[i] == py[start] && px[i] < px[start]))
+            start = i;
+    }
+
+    // a hull has at most n vertices, so the loop always closes before that
+    int p = start;
+    for (int step = 0; step < n; ++step) {
+        if (control && control->isCancelled()) return;
+        outHull.push_back(p);
+        int next = p;
+        for (int i = 0; i < n; ++i)
+            if (wrapsBefore(points, p, i, next, iterations)) next = i;
+        // only copies of p left, or back at the start (or a copy of it)
+        if (px[next] == px[p] && py[next] == py[p]) break;
+        if (px[next] == px[start] && py[next] == py[start]) break;
+        p = next;
+    }
+    if (control) control->report(1.0);
+}
+
+template <typename T>
+void computeGiftWrapping(BasicPointsView<T> points, std::int64_t &iterations, std::vector<int> &outHull,
+                         RunControl *control, const HullOptions &options)
+{
+    withCounter(iterations, options, [&](auto &counter) {
+        giftWrapping(points, counter, outHull, control);
+    });
+}
+
+// side test of the brute force for coordinate types the SIMD kernels don't
+// cover; same early exit as the kernels
+template <typename T>
+static SideScan scalarSideScan(const T *x, const T *y, std::size_t n, T xi, T yi, T xj, T yj)
+{
+    bool pos = false, neg = false;
+    std::size_t k = 0;
+    for (; k < n; ++k) {
+        const int o = orientation(xi, yi, xj, yj, x[k], y[k]);
+        pos |= o > 0;
+        neg |= o < 0;
+        if (pos && neg) { ++k; break; }
+    }
+    return {pos, neg, std::int64_t(k)};
+}
+
+// Slow brute-force convex hull: check every pair (i,j) if all points are on
+// one side of the line i->j. All points left of (or on) i->j make it a
+// counter-clockwise hull edge, recorded as next[i] = j; of several such j on
+// one boundary line the farthest wins, so following next[] from a proper
+// vertex skips collinear boundary points and yields the hull in order.
+template <typename T, typename Counter>
+static void slowConvexHull(BasicPointsView<T> points, Counter &iterations, std::vector<int> &outHull,
+                           RunControl *control, const HullOptions &options)
+{
+    assert(inExactRange(points));
+    outHull.clear();
+    int n = static_cast<int>(points.size);
+    if (n == 0) return;
+    const T *px = points.x;
+    const T *py = points.y;
+
+    // progress is the share of (i,j) pairs done: rows i.. still hold (n-i)(n-i-1)/2 of them
+    const double totalPairs = 0.5 * n * (n - 1);
+    SideScanFn scanDouble = nullptr;
+    if constexpr (std::is_same_v<T, double>) scanDouble = sideScanKernel();
+    auto scan = [&](T xi, T yi, T xj, T yj) {
+        if constexpr (std::is_same_v<T, double>) return scanDouble(px, py, n, xi, yi, xj, yj);
+        else return scalarSideScan(px, py, n, xi, yi, xj, yj);
+    };
+    auto same = [&](int a, int b) { return px[a] == px[b] && py[a] == py[b]; };
+    // a farther from i than b, both on one ray from i; copies of i are nearest
+    auto farther = [&](int i, int a, int b) {
+        if (same(b, i)) return !same(a, i);
+        if (px[b] != px[i]) return px[a] != px[b] && (px[a] > px[b]) == (px[b] > px[i]);
+        return py[a] != py[b] && (py[a] > py[b]) == (py[b] > py[i]);
+    };
+    std::pmr::memory_resource *scratch = scratchResource(options.arena);
+    std::pmr::vector<int> next(n, -1, scratch);
+    PhaseTimer edgeTimer(options.profile, Phase::EdgeTest);
+    auto addEdge = [&](int from, int to) {
+        if (next[from] < 0 || farther(from, to, next[from])) next[from] = to;
+    };
+    for (int i = 0; i < n; ++i) {
+        if (control) {
+            if (control->isCancelled()) return;
+            const double left = 0.5 * (n - i) * (n - i - 1);
+            control->report(1.0 - left / totalPairs);
+        }
+        for (int j = i+1; j < n; ++j) {
+            // orientation(i, j, k) over every k. No need to skip k == i or
+            // j: their orientation is exactly zero.
+            const SideScan side = scan(px[i], py[i], px[j], py[j]);
+            iterations.add(side.checked);
+            if (!side.neg) addEdge(i, j);
+            if (!side.pos) addEdge(j, i);
+        }
+    }
+
+    edgeTimer.stop();
+
+    // walk from the lowest (then leftmost) point, a proper vertex, until the
+    // walk returns to its position; marks stop it on anything unexpected
+    int start = 0;
+    for (int i = 1; i < n; ++i)
+        if (py[i] < py[start] || (py[i] == py[start] && px[i] < px[start])) start = i;
+    PhaseTimer walkTimer(options.profile, Phase::HullWalk);
+    std::pmr::vector<char> onHull(n, 0, scratch);
+    for (int v = start; v >= 0 && !onHull[v]; v = next[v]) {
+        if (v != start && same(v, start)) break;
+        onHull[v] = 1;
+        outHull.push_back(v);
+    }
+    if (control) control->report(1.0);
+}
+
+template <typename T>
+void computeSlowConvexHull(BasicPointsView<T> points, std::int64_t &iterations, std::vector<int> &outHull,
+                           RunControl *control, const HullOptions &options)
+{
+    withCounter(iterations, options, [&](auto &counter) {
+        slowConvexHull(points, counter, outHull, control, options);
+    });
+}
+
+template <typename T>
+void aklToussaintFilter(BasicPointsView<T> points, BasicPointStore<T> &survivors,
+                        std::vector<int> &originalIndex)
+{
+    assert(inExactRange(points));
+    TraceSpan span("Akl-Toussaint filter", "engine");
+    // direction keys and half-planes are evaluated in the wide type, which
+    // keeps them exact for integer coordinates
+    using Wide = typename CoordTraits<T>::Wide;
+    constexpr bool exact = !std::is_floating_point_v<Wide>;
+    const int n = static_cast<int>(points.size);
+    survivors.clear();
+    originalIndex.clear();
+    if (n == 0) return;
+
+    // extremes in counter-clockwise direction order: min y, max x-y, max x,
+    // max x+y, max y, min x-y, min x, min x+y
+    int ext[8] = {0, 0, 0, 0, 0, 0, 0, 0};
+    Wide best[8];
+    auto keys = [](const BasicPoint<T> &p, Wide *k) {
+        const Wide x = p.x, y = p.y;
+        k[0] = -y;          k[1] = x - y;
+        k[2] = x;           k[3] = x + y;
+        k[4] = y;           k[5] = y - x;
+        k[6] = -x;          k[7] = -x - y;
+    };
+    keys(points[0], best);
+    for (int i = 1; i < n; ++i) {
+        Wide k[8];
+        keys(points[i], k);
+        for (int d = 0; d < 8; ++d) {
+            if (k[d] > best[d]) { best[d] = k[d]; ext[d] = i; }
+        }
+    }
+
+    // octagon vertices with repeats removed; it degenerates for tiny inputs
+    BasicPoint<T> poly[8];
+    int m = 0;
+    for (int d = 0; d < 8; ++d) {
+        const BasicPoint<T> p = points[ext[d]];
+        if (m > 0 && poly[m-1].x == p.x && poly[m-1].y == p.y) continue;
+        poly[m++] = p;
+    }
+    while (m > 1 && poly[m-1].x == poly[0].x && poly[m-1].y == poly[0].y) --m;
+
+    // edge half-planes nx*x + ny*y + c > tol, padded to eight with planes
+    // every point passes so the inner loop has a fixed trip count
+    Wide nx[8], ny[8], c[8], tol[8];
+    double scale = 0;
+    if constexpr (!exact) {
+        for (int v = 0; v < m; ++v) scale = std::max(scale, std::max(std::abs(double(poly[v].x)), std::abs(double(poly[v].y))));
+    }
+    int edges = 0;
+    for (int v = 0; v < m && m >= 3; ++v) {
+        const BasicPoint<T> &a = poly[v];
+        const BasicPoint<T> &b = poly[(v + 1) % m];
+        nx[edges] = Wide(a.y) - b.y;
+        ny[edges] = Wide(b.x) - a.x;
+        c[edges] = -(nx[edges] * a.x + ny[edges] * a.y);
+        if constexpr (exact) {
+            tol[edges] = 0;
+        } else {
+            // generous bound on the rounding error of building and evaluating
+            // the plane; scale covers every point since the extremes include
+            // min/max x and y
+            tol[edges] = 16 * std::numeric_limits<double>::epsilon()
+                       * (std::abs(nx[edges]) + std::abs(ny[edges])) * scale;
+        }
+        ++edges;
+    }
+    if (edges == 0) {
+        // collinear or fewer than three distinct extremes: nothing is inside
+        survivors.resize(n);
+        std::copy(points.x, points.x + n, survivors.xs());
+        std::copy(points.y, points.y + n, survivors.ys());
+        originalIndex.resize(n);
+        for (int i = 0; i < n; ++i) originalIndex[i] = i;
+        return;
+    }
+    for (; edges < 8; ++edges) {
+        nx[edges] = 0; ny[edges] = 0; c[edges] = 1; tol[edges] = 0;
+    }
+
+    // one branch-free pass; survivors are compacted by advancing the write
+    // position only for points outside (or on) the octagon
+    survivors.resize(n);
+    originalIndex.resize(n);
+    T *sx = survivors.xs();
+    T *sy = survivors.ys();
+    int *orig = originalIndex.data();
+    int kept = 0;
+    for (int i = 0; i < n; ++i) {
+        const T x = points.x[i];
+        const T y = points.y[i];
+        bool inside = true;
+        for (int e = 0; e < 8; ++e)
+            inside &= nx[e] * x + ny[e] * y + c[e] > tol[e];
+        sx[kept] = x;
+        sy[kept] = y;
+        orig[kept] = i;
+        kept += !inside;
+    }
+    survivors.resize(kept);
+    originalIndex.resize(kept);
+}
+
+#define HULL_INSTANTIATE_ENGINES(T) \
+    template void computeHull<T>(Algorithm, BasicPointsView<T>, std::int64_t &, std::vector<int> &, RunControl *, \
+                                 const HullOptions &); \
+    template void computeGrahamScan<T>(BasicPointsView<T>, std::int64_t &, std::vector<int> &, RunControl *, \
+                                       const HullOptions &); \
+    template void computeMonotoneChain<T>(BasicPointsView<T>, std::int64_t &, std::vector<int> &, RunControl *, \
+                                          const HullOptions &); \
+    template void computeChan<T>(BasicPointsView<T>, std::int64_t &, std::vector<int> &, RunControl *, \
+                                 const HullOptions &); \
+    template void computeQuickHull<T>(BasicPointsView<T>, std::int64_t &, std::vector<int> &, RunControl *, \
+                                      const HullOptions &); \
+    template void computeParallelHull<T>(BasicPointsView<T>, std::int64_t &, std::vector<int> &, RunControl *, int, \
+                                         const HullOptions &); \
+    template void computeHulls<T>(BasicPointSets<T>, std::int64_t &, HullSets &, RunControl *, \
+                                  const HullOptions &); \
+    template void computeReference<T>(Reference, BasicPointsView<T>, std::int64_t &, std::vector<int> &, RunControl *, \
+                                      const HullOptions &); \
+    template void computeGiftWrapping<T>(BasicPointsView<T>, std::int64_t &, std::vector<int> &, RunControl *, \
+                                         const HullOptions &); \
+    template void computeSlowConvexHull<T>(BasicPointsView<T>, std::int64_t &, std::vector<int> &, RunControl *, \
+                                           const HullOptions &); \
+    template void aklToussaintFilter<T>(BasicPointsView<T>, BasicPointStore<T> &, std::vector<int> &);
+
+HULL_INSTANTIATE_ENGINES(std::int32_t)
+#ifdef HULL_HAVE_INT128
+HULL_INSTANTIATE_ENGINES(std::int64_t)
+#endif
+HULL_INSTANTIATE_ENGINES(float)
+HULL_INSTANTIATE_ENGINES(double)
+
+#undef HULL_INSTANTIATE_ENGINES
+
+} // namespace hull
@@ -0,0 +1,238 @@
+#ifndef HULLENGINE_H
+#define HULLENGINE_H
+
+#include "arena.h"
+#include "geometry.h"
+#include "instrument.h"
+#include "pointstore.h"
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+// Headless convex hull engines. Nothing in here depends on Qt, so the same
+// code runs inside DrawingWidget and in batch jobs on machines without a
+// display. Every engine takes a view of points and writes indices into that
+// view to outHull; iterations receives a rough count of the work done.
+namespace hull {
+
+class TaskPool;
+
+// Cooperative cancellation and progress for runs on a worker thread. Engines
+// poll isCancelled() between outer steps and return early with whatever
+// partial output they have; callers own the control and check it afterwards.
+// Progress is published in percent of the whole run: an engine reports the
+// fraction of its own work and the caller picks the slice (base, span) of the
+// run that engine occupies.
+struct RunControl
+{
+    std::atomic<bool> cancelled{false};
+    std::atomic<int> progress{0};
+    int progressBase = 0;
+    int progressSpan = 100;
+
+    bool isCancelled() const { return cancelled.load(std::memory_order_relaxed); }
+    void report(double fraction)
+    {
+        progress.store(progressBase + static_cast<int>(fraction * progressSpan), std::memory_order_relaxed);
+    }
+};
+
+enum class Algorithm
+{
+    GrahamScan,
+    MonotoneChain,
+    ParallelGraham,
+    Chan,
+    QuickHull
+};
+
+// display name, e.g. "Graham" for the stats overlay
+const char *algorithmName(Algorithm algorithm);
+
+// How the Graham scan orders points by angle around its pivot. Comparison
+// is std::sort with the exact orientation comparator. Radix packs a
+// pseudo-angle (no atan2) and a distance per point into one 64-bit key, sorts
+// the keys with an LSD radix sort in a few linear passes and then repairs
+// the few pairs rounding put out of order with an insertion pass using the
+// exact comparator.
+enum class AngularSort
+{
+    Comparison,
+    Radix
+};
+
+// tuning knobs for the engines that have any; the defaults match the
+// behaviour before each knob was added
+struct HullOptions
+{
+    AngularSort angularSort = AngularSort::Comparison;
+    // comparison sorts of at least this many points run in parallel on the
+    // pool: sorted chunks, then rounds of merges split across it. Has no
+    // effect when the pool has a single thread.
+    std::size_t parallelSortThreshold = std::size_t(1) << 16;
+    // pool the parallel engines run their tasks on; TaskPool::global() when
+    // null
+    TaskPool *pool = nullptr;
+    // scratch buffers come from here when set, from the default memory
+    // resource otherwise; the caller resets it between runs
+    Arena *arena = nullptr;
+    // engines with phases (see Phase) add their wall time and hardware
+    // counters here when set; the caller clears it between runs
+    RunProfile *profile = nullptr;
+    // false runs the engines built without iteration counting, which leaves
+    // the comparators and inner loops free of counter updates; iterations
+    // then comes back 0. Building with HULL_NO_ITERATION_COUNTS never counts.
+    bool countIterations = true;
+};
+
+// Reference engines the fast ones are checked against: they take no
+// shortcuts worth getting wrong. Brute force is the oracle of record;
+// gift wrapping is O(nh) and stays usable on validation sets far beyond the
+// few thousand points brute force can handle.
+enum class Reference
+{
+    BruteForce,
+    GiftWrapping
+};
+
+// display name, e.g. "brute" for the stats overlay
+const char *referenceName(Reference reference);
+
+// Every engine is a template over the coordinate type and is instantiated in
+// hullengine.cpp for std::int32_t, std::int64_t (where the compiler has a
+// 128-bit integer), float and double; see CoordTraits in geometry.h for the
+// exact coordinate range of the integer types, which debug builds assert on
+// entry. Integer inputs take exact wide cross products and no tolerances
+// anywhere, and int32 packs twice as many points per cache line as double.
+
+// runs the selected O(n log n) engine
+template <typename T>
+void computeHull(Algorithm algorithm, BasicPointsView<T> points, std::int64_t &iterations,
+                 std::vector<int> &outHull, RunControl *control = nullptr,
+                 const HullOptions &options = HullOptions());
+
+// Graham scan, O(n log n). Hull is counter-clockwise starting at the lowest
+// point. options.angularSort picks the sort stage; a comparison sort above
+// options.parallelSortThreshold runs in parallel.
+template <typename T>
+void computeGrahamScan(BasicPointsView<T> points, std::int64_t &iterations, std::vector<int> &outHull,
+                       RunControl *control = nullptr, const HullOptions &options = HullOptions());
+
+// Andrew's monotone chain, O(n log n): lexicographic sort, then one pass each
+// for the lower and upper chain. No angle comparator and no collinear filter.
+// Hull is counter-clockwise starting at the leftmost (then lowest) point.
+template <typename T>
+void computeMonotoneChain(BasicPointsView<T> points, std::int64_t &iterations, std::vector<int> &outHull,
+                          RunControl *control = nullptr, const HullOptions &options = HullOptions());
+
+// Chan's algorithm, O(n log h) for h hull vertices: for m = 4, 16, 256, ...
+// (squaring each round) it splits the points into groups of m, takes the
+// monotone chain hull of every group and gift-wraps over the group hulls
+// with a binary-search tangent per group, giving up after m wrapping steps.
+// iterations counts orientation tests in both stages, so on inputs with few
+// hull vertices it grows like n log h rather than n log n. Hull is
+// counter-clockwise starting at the lowest (then leftmost) point.
+template <typename T>
+void computeChan(BasicPointsView<T> points, std::int64_t &iterations, std::vector<int> &outHull,
+                 RunControl *control = nullptr, const HullOptions &options = HullOptions());
+
+// QuickHull: splits the points by the line through the lexicographically
+// smallest and largest point, then recursively finds the point farthest
+// outside each hull edge and discards everything inside the triangle it
+// spans. Partitioning happens in place on one index array; large
+// subproblems run as tasks on options.pool. Expected O(n log h) on
+// typical clouds, O(n^2) worst case. Hull is counter-clockwise starting at
+// the leftmost (then lowest) point.
+template <typename T>
+void computeQuickHull(BasicPointsView<T> points, std::int64_t &iterations, std::vector<int> &outHull,
+                      RunControl *control = nullptr, const HullOptions &options = HullOptions());
+
+// Parallel divide and conquer: splits points into one contiguous chunk per
+// pool thread, runs computeGrahamScan on every chunk as a task on
+// options.pool and then takes the Graham hull of the chunk hulls.
+// threads <= 0 uses one chunk per pool thread; small inputs use fewer chunks
+// so each task has real work. options go to every Graham scan.
+template <typename T>
+void computeParallelHull(BasicPointsView<T> points, std::int64_t &iterations, std::vector<int> &outHull,
+                         RunControl *control = nullptr, int threads = 0,
+                         const HullOptions &options = HullOptions());
+
+// Many point sets in one flat layout, CSR style: set s is
+// points[offsets[s]] .. points[offsets[s + 1] - 1]. offsets holds count + 1
+// ascending entries, the first 0 and the last points.size.
+template <typename T>
+struct BasicPointSets
+{
+    BasicPointsView<T> points;
+    const int *offsets = nullptr;
+    std::size_t count = 0;
+
+    BasicPointsView<T> set(std::size_t s) const
+    {
+        return points.slice(offsets[s], offsets[s + 1] - offsets[s]);
+    }
+};
+
+using PointSets = BasicPointSets<double>;
+
+// Hulls of a BasicPointSets in the same layout: hull s is
+// indices[offsets[s]] .. indices[offsets[s + 1] - 1], indices into the sets'
+// flat points. Reusing one HullSets across calls reuses its buffers.
+struct HullSets
+{
+    std::vector<int> offsets;
+    std::vector<int> indices;
+
+    std::size_t count() const { return offsets.empty() ? 0 : offsets.size() - 1; }
+    int hullSize(std::size_t s) const { return offsets[s + 1] - offsets[s]; }
+};
+
+// Batch engine for many small sets (tens to hundreds of points each): the
+// monotone chain hull of every set, in computeMonotoneChain's order. Sets are
+// dealt out as tasks on options.pool in runs of roughly equal point
+// counts; every task takes its sort and stack buffers from options.arena (or
+// the heap) once, sized for its largest set, and writes hulls straight into
+// out.indices at their set's offset, so nothing is allocated per set. The
+// hulls are compacted afterwards. iterations is the total over all sets.
+template <typename T>
+void computeHulls(BasicPointSets<T> sets, std::int64_t &iterations, HullSets &out,
+                  RunControl *control = nullptr, const HullOptions &options = HullOptions());
+
+// runs the selected reference engine
+template <typename T>
+void computeReference(Reference reference, BasicPointsView<T> points, std::int64_t &iterations,
+                      std::vector<int> &outHull, RunControl *control = nullptr,
+                      const HullOptions &options = HullOptions());
+
+// Gift wrapping (Jarvis march), O(nh) for h hull vertices: starting at the
+// lowest (then leftmost) point, every step scans all points for the one the
+// rest lie left of. Emits the vertices in order, counter-clockwise from the
+// start; collinear boundary points are not vertices.
+template <typename T>
+void computeGiftWrapping(BasicPointsView<T> points, std::int64_t &iterations, std::vector<int> &outHull,
+                         RunControl *control = nullptr, const HullOptions &options = HullOptions());
+
+// Brute force, O(n^3): every pair (i,j) is an edge if all other points lie on one side.
+// Edges go into a flat successor array, which gives the vertices in order:
+// counter-clockwise from the lowest (then leftmost) point, collinear
+// boundary points excluded. For double the side test over all k runs
+// through the SIMD kernel in orientkernel.h; other coordinate types use a
+// scalar loop.
+template <typename T>
+void computeSlowConvexHull(BasicPointsView<T> points, std::int64_t &iterations, std::vector<int> &outHull,
+                           RunControl *control = nullptr, const HullOptions &options = HullOptions());
+
+// Akl-Toussaint prefilter: finds the extreme points in the directions
+// min/max x, y, x+y and x-y and drops every point strictly inside the octagon
+// they span, which can't be on the hull. survivors receives the remaining
+// points, originalIndex the index in points of each survivor, so a hull
+// computed over survivors maps back with originalIndex[h]. With floating
+// coordinates, points close enough to an octagon edge that rounding could
+// misplace them are kept; with integers the test is exact.
+template <typename T>
+void aklToussaintFilter(BasicPointsView<T> points, BasicPointStore<T> &survivors,
+                        std::vector<int> &originalIndex);
+
+} // namespace hull
+
+#endif // HULLENGINE_H
@@ -0,0 +1,25 @@
+# sources of the hull engine, shared by hullengine.pro and the apps using it
+INCLUDEPATH += $$PWD
+DEPENDPATH  += $$PWD
+
+SOURCES += $$PWD/hullengine.cpp \
+           $$PWD/predicates.cpp \
+           $$PWD/orientkernel.cpp \
+           $$PWD/taskpool.cpp \
+           $$PWD/dynamichull.cpp \
+           $$PWD/arena.cpp \
+           $$PWD/generator.cpp \
+           $$PWD/instrument.cpp \
+           $$PWD/trace.cpp
+
+HEADERS += $$PWD/geometry.h \
+           $$PWD/pointstore.h \
+           $$PWD/predicates.h \
+           $$PWD/orientkernel.h \
+           $$PWD/taskpool.h \
+           $$PWD/hullengine.h \
+           $$PWD/dynamichull.h \
+           $$PWD/arena.h \
+           $$PWD/generator.h \
+           $$PWD/instrument.h \
+           $$PWD/trace.h
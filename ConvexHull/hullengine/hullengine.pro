@@ -0,0 +1,13 @@
+# GUI-free hull engine. Builds a static library that batch jobs can link
+# without pulling in Qt; the desktop app compiles the same sources through
+# hullengine.pri.
+TEMPLATE = lib
+TARGET   = hullengine
+CONFIG  += staticlib c++17 thread
+CONFIG  -= qt
+
+include(hullengine.pri)
+
+# batch jobs don't read iteration counts: release builds of the library
+# compile the counting out of the engines (see HullOptions::countIterations)
+CONFIG(release, debug|release): DEFINES += HULL_NO_ITERATION_COUNTS
@@ -0,0 +1,162 @@
+#include "instrument.h"
+
+#ifdef __linux__
+#include <cstring>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace hull {
+
+namespace {
+
+// one counter group per thread, opened on the thread's first phase:
+// cycles as the leader, then instructions, cache misses and branch misses,
+// read together in one read()
+struct CounterGroup
+{
+    int fds[4] = {-1, -1, -1, -1};
+    bool opened = false;
+
+    ~CounterGroup()
+    {
+#ifdef __linux__
+        for (int fd : fds)
+            if (fd >= 0) close(fd);
+#endif
+    }
+
+    bool available()
+    {
+        if (!opened) open();
+        return fds[0] >= 0;
+    }
+
+    void open()
+    {
+        opened = true;
+#ifdef __linux__
+        const std::uint64_t configs[4] = {
+            PERF_COUNT_HW_CPU_CYCLES,
+            PERF_COUNT_HW_INSTRUCTIONS,
+            PERF_COUNT_HW_CACHE_MISSES,
+            PERF_COUNT_HW_BRANCH_MISSES,
+        };
+        for (int i = 0; i < 4; ++i) {
+            perf_event_attr attr;
+            std::memset(&attr, 0, sizeof attr);
+            attr.size = sizeof attr;
+            attr.type = PERF_TYPE_HARDWARE;
+            attr.config = configs[i];
+            attr.read_format = PERF_FORMAT_GROUP;
+            attr.exclude_kernel = 1;
+            attr.exclude_hv = 1;
+            fds[i] = int(syscall(SYS_perf_event_open, &attr, 0, -1, i == 0 ? -1 : fds[0], 0));
+            if (fds[i] < 0) {
+                // all or nothing, so a phase never reports half its counters
+                for (int j = 0; j < i; ++j) {
+                    close(fds[j]);
+                    fds[j] = -1;
+                }
+                return;
+            }
+        }
+#endif
+    }
+
+    bool read(std::int64_t *values)
+    {
+        if (!available()) return false;
+#ifdef __linux__
+        std::uint64_t buffer[5]; // nr, then one value per counter
+        if (::read(fds[0], buffer, sizeof buffer) != ssize_t(sizeof buffer) || buffer[0] != 4) return false;
+        for (int i = 0; i < 4; ++i) values[i] = std::int64_t(buffer[i + 1]);
+        return true;
+#else
+        (void)values;
+        return false;
+#endif
+    }
+};
+
+thread_local CounterGroup counterGroup;
+
+} // namespace
+
+const char *phaseName(Phase phase)
+{
+    switch (phase) {
+    case Phase::PivotSearch: return "pivot search";
+    case Phase::AngularSort: return "angular sort";
+    case Phase::CollinearFilter: return "collinear filter";
+    case Phase::StackScan: return "stack scan";
+    case Phase::EdgeTest: return "edge test";
+    case Phase::HullWalk: return "hull walk";
+    }
+    return "";
+}
+
+bool hardwareCountersAvailable()
+{
+    return counterGroup.available();
+}
+
+void RunProfile::add(Phase phase, const PhaseStats &delta)
+{
+    PhaseStats &s = stats[int(phase)];
+    // a counter stays -1 only while no call had it
+    auto sum = [](std::int64_t &to, std::int64_t value) {
+        if (value < 0) return;
+        to = to < 0 ? value : to + value;
+    };
+    s.calls += delta.calls;
+    s.seconds += delta.seconds;
+    sum(s.cycles, delta.cycles);
+    sum(s.instructions, delta.instructions);
+    sum(s.cacheMisses, delta.cacheMisses);
+    sum(s.branchMisses, delta.branchMisses);
+}
+
+void RunProfile::merge(const RunProfile &other)
+{
+    for (int p = 0; p < phaseCount; ++p) add(Phase(p), other.stats[p]);
+}
+
+bool RunProfile::empty() const
+{
+    for (const PhaseStats &s : stats)
+        if (s.calls > 0) return false;
+    return true;
+}
+
+PhaseTimer::PhaseTimer(RunProfile *profile, Phase phase)
+    : profile(profile), phase(phase), span(phaseName(phase), "phase")
+{
+    if (!profile) return;
+    counting = counterGroup.read(counters);
+    // the clock last, so the counter read isn't part of the phase
+    start = std::chrono::steady_clock::now();
+}
+
+void PhaseTimer::stop()
+{
+    span.stop();
+    if (!profile) return;
+    const std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+    PhaseStats delta;
+    delta.calls = 1;
+    delta.seconds = std::chrono::duration<double>(end - start).count();
+    std::int64_t after[4];
+    if (counting && counterGroup.read(after)) {
+        delta.cycles = after[0] - counters[0];
+        delta.instructions = after[1] - counters[1];
+        delta.cacheMisses = after[2] - counters[2];
+        delta.branchMisses = after[3] - counters[3];
+    }
+    profile->add(phase, delta);
+    profile = nullptr;
+}
+
+} // namespace hull
@@ -0,0 +1,93 @@
+#ifndef HULL_INSTRUMENT_H
+#define HULL_INSTRUMENT_H
+
+#include "trace.h"
+#include <chrono>
+#include <cstdint>
+
+namespace hull {
+
+// Phases the engines report separately; iterations still sums all of them.
+//   PivotSearch      Graham: lowest point
+//   AngularSort      Graham: sort around the pivot (either sort mode)
+//   CollinearFilter  Graham: keeping the farthest point of each ray
+//   StackScan        Graham: the turn test stack pass
+//   EdgeTest         brute force: side test of every pair
+//   HullWalk         brute force: following the successor array in order
+enum class Phase
+{
+    PivotSearch,
+    AngularSort,
+    CollinearFilter,
+    StackScan,
+    EdgeTest,
+    HullWalk
+};
+
+constexpr int phaseCount = 6;
+
+// display name, e.g. "angular sort"
+const char *phaseName(Phase phase);
+
+// Hardware counters from perf_event_open. They count the thread that runs
+// the phase in user mode only, so tasks a phase hands to other pool threads
+// show up in its wall time but not in its counters. -1 where they are
+// unavailable: not Linux, no PMU (most VMs and containers) or a
+// perf_event_paranoid setting that forbids them.
+struct PhaseStats
+{
+    int calls = 0;
+    double seconds = 0;
+    std::int64_t cycles = -1;
+    std::int64_t instructions = -1;
+    std::int64_t cacheMisses = -1;
+    std::int64_t branchMisses = -1;
+};
+
+// Per-run measurements, filled by engines given one through
+// HullOptions::profile. Plain data: copy it, merge it, clear it between runs.
+// Not thread-safe; engines that run phases in several tasks give each its
+// own profile and merge afterwards.
+class RunProfile
+{
+public:
+    const PhaseStats &operator[](Phase phase) const { return stats[int(phase)]; }
+    void add(Phase phase, const PhaseStats &delta);
+    void merge(const RunProfile &other);
+    void clear() { *this = RunProfile(); }
+    bool empty() const;
+
+private:
+    PhaseStats stats[phaseCount];
+};
+
+// Measures the scope it lives in as one call of phase into profile; does
+// nothing when profile is null, so engines can declare it unconditionally.
+// With tracing on it also records the phase as a span.
+class PhaseTimer
+{
+public:
+    PhaseTimer(RunProfile *profile, Phase phase);
+    ~PhaseTimer() { stop(); }
+
+    PhaseTimer(const PhaseTimer &) = delete;
+    PhaseTimer &operator=(const PhaseTimer &) = delete;
+
+    // ends the measurement early; later calls do nothing
+    void stop();
+
+private:
+    RunProfile *profile;
+    Phase phase;
+    TraceSpan span;
+    std::chrono::steady_clock::time_point start;
+    std::int64_t counters[4];
+    bool counting = false;
+};
+
+// true when this thread can read the hardware counters
+bool hardwareCountersAvailable();
+
+} // namespace hull
+
+#endif // HULL_INSTRUMENT_H
@@ -0,0 +1,166 @@
+#include "orientkernel.h"
+#include "predicates.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define HULL_X86_SIMD 1
+#include <immintrin.h>
+#endif
+
+namespace hull {
+
+static SideScan sideScanScalar(const double *x, const double *y, std::size_t n,
+                               double xi, double yi, double xj, double yj)
+{
+    bool pos = false, neg = false;
+    std::size_t k = 0;
+    for (; k < n; ++k) {
+        const int o = orientation(xi, yi, xj, yj, x[k], y[k]);
+        pos |= o > 0;
+        neg |= o < 0;
+        if (pos && neg) { ++k; break; }
+    }
+    return {pos, neg, std::int64_t(k)};
+}
+
+#ifdef HULL_X86_SIMD
+
+// Both SIMD kernels compute per lane
+//     left = dx * (y - yi), right = dy * (x - xi), det = left - right
+// and accept the sign of det when |det| > bound * (|left| + |right|), the
+// same filter as orientation(). Lanes with both terms zero are exactly zero.
+// Whatever is left undecided goes through the exact predicate.
+
+__attribute__((target("avx2")))
+static SideScan sideScanAvx2(const double *x, const double *y, std::size_t n,
+                             double xi, double yi, double xj, double yj)
+{
+    const __m256d vxi = _mm256_set1_pd(xi);
+    const __m256d vyi = _mm256_set1_pd(yi);
+    const __m256d vdx = _mm256_set1_pd(xj - xi);
+    const __m256d vdy = _mm256_set1_pd(yj - yi);
+    const __m256d vbound = _mm256_set1_pd(orientationErrorBound);
+    const __m256d absMask = _mm256_castsi256_pd(_mm256_set1_epi64x(0x7fffffffffffffffLL));
+    const __m256d zero = _mm256_setzero_pd();
+    bool pos = false, neg = false;
+
+    std::size_t k = 0;
+    for (; k + 8 <= n; k += 8) {
+        int posBits = 0, negBits = 0, unsureBits = 0;
+        for (int h = 0; h < 2; ++h) {
+            const __m256d left = _mm256_mul_pd(vdx, _mm256_sub_pd(_mm256_loadu_pd(y + k + 4*h), vyi));
+            const __m256d right = _mm256_mul_pd(vdy, _mm256_sub_pd(_mm256_loadu_pd(x + k + 4*h), vxi));
+            const __m256d det = _mm256_sub_pd(left, right);
+            const __m256d bound = _mm256_mul_pd(vbound, _mm256_add_pd(_mm256_and_pd(left, absMask),
+                                                                      _mm256_and_pd(right, absMask)));
+            const __m256d isPos = _mm256_cmp_pd(det, bound, _CMP_GT_OQ);
+            const __m256d isNeg = _mm256_cmp_pd(_mm256_sub_pd(zero, det), bound, _CMP_GT_OQ);
+            const __m256d isZero = _mm256_cmp_pd(bound, zero, _CMP_EQ_OQ);
+            const __m256d decided = _mm256_or_pd(_mm256_or_pd(isPos, isNeg), isZero);
+            posBits |= _mm256_movemask_pd(isPos) << (4*h);
+            negBits |= _mm256_movemask_pd(isNeg) << (4*h);
+            unsureBits |= (~_mm256_movemask_pd(decided) & 0xf) << (4*h);
+        }
+        for (; unsureBits; unsureBits &= unsureBits - 1) {
+            const std::size_t lane = k + __builtin_ctz(unsureBits);
+            const int o = orientation(xi, yi, xj, yj, x[lane], y[lane]);
+            pos |= o > 0;
+            neg |= o < 0;
+        }
+        pos |= posBits != 0;
+        neg |= negBits != 0;
+        if (pos && neg)
+            return {true, true, std::int64_t(k + 8)};
+    }
+    SideScan tail = sideScanScalar(x + k, y + k, n - k, xi, yi, xj, yj);
+    tail.pos |= pos;
+    tail.neg |= neg;
+    tail.checked += std::int64_t(k);
+    return tail;
+}
+
+__attribute__((target("avx512f")))
+static SideScan sideScanAvx512(const double *x, const double *y, std::size_t n,
+                               double xi, double yi, double xj, double yj)
+{
+    const __m512d vxi = _mm512_set1_pd(xi);
+    const __m512d vyi = _mm512_set1_pd(yi);
+    const __m512d vdx = _mm512_set1_pd(xj - xi);
+    const __m512d vdy = _mm512_set1_pd(yj - yi);
+    const __m512d vbound = _mm512_set1_pd(orientationErrorBound);
+    const __m512d zero = _mm512_setzero_pd();
+    bool pos = false, neg = false;
+
+    std::size_t k = 0;
+    for (; k + 16 <= n; k += 16) {
+        unsigned posBits = 0, negBits = 0, unsureBits = 0;
+        for (int h = 0; h < 2; ++h) {
+            const __m512d left = _mm512_mul_pd(vdx, _mm512_sub_pd(_mm512_loadu_pd(y + k + 8*h), vyi));
+            const __m512d right = _mm512_mul_pd(vdy, _mm512_sub_pd(_mm512_loadu_pd(x + k + 8*h), vxi));
+            const __m512d det = _mm512_sub_pd(left, right);
+            const __m512d bound = _mm512_mul_pd(vbound, _mm512_add_pd(_mm512_abs_pd(left), _mm512_abs_pd(right)));
+            const __mmask8 isPos = _mm512_cmp_pd_mask(det, bound, _CMP_GT_OQ);
+            const __mmask8 isNeg = _mm512_cmp_pd_mask(_mm512_sub_pd(zero, det), bound, _CMP_GT_OQ);
+            const __mmask8 isZero = _mm512_cmp_pd_mask(bound, zero, _CMP_EQ_OQ);
+            posBits |= unsigned(isPos) << (8*h);
+            negBits |= unsigned(isNeg) << (8*h);
+            unsureBits |= unsigned(__mmask8(~(isPos | isNeg | isZero))) << (8*h);
+        }
+        for (; unsureBits; unsureBits &= unsureBits - 1) {
+            const std::size_t lane = k + __builtin_ctz(unsureBits);
+            const int o = orientation(xi, yi, xj, yj, x[lane], y[lane]);
+            pos |= o > 0;
+            neg |= o < 0;
+        }
+        pos |= posBits != 0;
+        neg |= negBits != 0;
+        if (pos && neg)
+            return {true, true, std::int64_t(k + 16)};
+    }
+    SideScan tail = sideScanScalar(x + k, y + k, n - k, xi, yi, xj, yj);
+    tail.pos |= pos;
+    tail.neg |= neg;
+    tail.checked += std::int64_t(k);
+    return tail;
+}
+
+#endif // HULL_X86_SIMD
+
+SimdLevel detectSimdLevel()
+{
+#ifdef HULL_X86_SIMD
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")) return SimdLevel::Avx512;
+    if (__builtin_cpu_supports("avx2")) return SimdLevel::Avx2;
+#endif
+    return SimdLevel::Scalar;
+}
+
+const char *simdLevelName(SimdLevel level)
+{
+    switch (level) {
+    case SimdLevel::Scalar: return "scalar";
+    case SimdLevel::Avx2: return "AVX2";
+    case SimdLevel::Avx512: return "AVX-512";
+    }
+    return "";
+}
+
+SideScanFn sideScanKernel(SimdLevel level)
+{
+#ifdef HULL_X86_SIMD
+    const SimdLevel supported = detectSimdLevel();
+    if (level == SimdLevel::Avx512 && supported == SimdLevel::Avx512) return sideScanAvx512;
+    if (level == SimdLevel::Avx2 && supported != SimdLevel::Scalar) return sideScanAvx2;
+#else
+    (void)level;
+#endif
+    return sideScanScalar;
+}
+
+SideScanFn sideScanKernel()
+{
+    static const SideScanFn kernel = sideScanKernel(detectSimdLevel());
+    return kernel;
+}
+
+} // namespace hull
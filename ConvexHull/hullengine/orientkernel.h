@@ -0,0 +1,44 @@
+#ifndef HULL_ORIENTKERNEL_H
+#define HULL_ORIENTKERNEL_H
+
+#include <cstddef>
+#include <cstdint>
+
+// Vectorized orientation scan for the brute-force hull. For the line from
+// (xi, yi) to (xj, yj) the kernel evaluates orientation(i, j, k) for k in
+// [0, n) and records whether some k lies strictly left (pos) and some lies
+// strictly right (neg), stopping at the first block where both were seen.
+// Lanes use the floating-point filter of predicates.h; the rare lanes it
+// can't decide are redone with the exact predicate, so the answer is exact.
+// The implementation is picked once at runtime from the CPU's features.
+namespace hull {
+
+enum class SimdLevel
+{
+    Scalar,
+    Avx2,    // 4 doubles per vector, two vectors per block
+    Avx512   // 8 doubles per vector, two vectors per block
+};
+
+struct SideScan
+{
+    bool pos;
+    bool neg;
+    std::int64_t checked; // points evaluated before the scan stopped
+};
+
+using SideScanFn = SideScan (*)(const double *x, const double *y, std::size_t n,
+                                double xi, double yi, double xj, double yj);
+
+// best level this CPU and build support
+SimdLevel detectSimdLevel();
+const char *simdLevelName(SimdLevel level);
+
+// kernel for a level; levels the CPU lacks fall back to the scalar kernel
+SideScanFn sideScanKernel(SimdLevel level);
+// kernel for detectSimdLevel(), resolved on first use
+SideScanFn sideScanKernel();
+
+} // namespace hull
+
+#endif // HULL_ORIENTKERNEL_H
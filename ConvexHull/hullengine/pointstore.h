@@ -0,0 +1,77 @@
+#ifndef HULL_POINTSTORE_H
+#define HULL_POINTSTORE_H
+
+#include "geometry.h"
+#include <cstddef>
+#include <new>
+#include <vector>
+
+namespace hull {
+
+// std::allocator replacement handing out memory aligned to Alignment bytes,
+// so coordinate arrays start on a cache line and vector loads never split
+template <typename T, std::size_t Alignment = 64>
+struct AlignedAllocator
+{
+    using value_type = T;
+
+    template <typename U>
+    struct rebind { using other = AlignedAllocator<U, Alignment>; };
+
+    AlignedAllocator() = default;
+    template <typename U>
+    AlignedAllocator(const AlignedAllocator<U, Alignment> &) {}
+
+    T *allocate(std::size_t n)
+    {
+        return static_cast<T *>(::operator new(n * sizeof(T), std::align_val_t(Alignment)));
+    }
+    void deallocate(T *p, std::size_t)
+    {
+        ::operator delete(p, std::align_val_t(Alignment));
+    }
+
+    template <typename U>
+    bool operator==(const AlignedAllocator<U, Alignment> &) const { return true; }
+    template <typename U>
+    bool operator!=(const AlignedAllocator<U, Alignment> &) const { return false; }
+};
+
+// Owning point storage as two contiguous, cache-line aligned coordinate
+// arrays (structure of arrays). Engines read it through view(); GUI code
+// reads single points with operator[].
+template <typename T>
+class BasicPointStore
+{
+public:
+    using Coordinates = std::vector<T, AlignedAllocator<T>>;
+
+    std::size_t size() const { return xv.size(); }
+    bool empty() const { return xv.empty(); }
+
+    void reserve(std::size_t n) { xv.reserve(n); yv.reserve(n); }
+    void resize(std::size_t n) { xv.resize(n); yv.resize(n); }
+    void clear() { xv.clear(); yv.clear(); }
+
+    void append(T x, T y) { xv.push_back(x); yv.push_back(y); }
+    void set(std::size_t i, T x, T y) { xv[i] = x; yv[i] = y; }
+
+    BasicPoint<T> operator[](std::size_t i) const { return {xv[i], yv[i]}; }
+
+    T *xs() { return xv.data(); }
+    T *ys() { return yv.data(); }
+    const T *xs() const { return xv.data(); }
+    const T *ys() const { return yv.data(); }
+
+    BasicPointsView<T> view() const { return {xv.data(), yv.data(), xv.size()}; }
+
+private:
+    Coordinates xv;
+    Coordinates yv;
+};
+
+using PointStore = BasicPointStore<double>;
+
+} // namespace hull
+
+#endif // HULL_POINTSTORE_H
@@ -0,0 +1,78 @@
+#include "predicates.h"
+#include <cmath>
+
+namespace hull {
+
+// a + b = sum + err exactly (Knuth's two-sum)
+static inline void twoSum(double a, double b, double &sum, double &err)
+{
+    sum = a + b;
+    const double bv = sum - a;
+    const double av = sum - bv;
+    err = (a - av) + (b - bv);
+}
+
+// a * b = product + err exactly; fma rounds only once, so it recovers the
+// low half of the product
+static inline void twoProduct(double a, double b, double &product, double &err)
+{
+    product = a * b;
+    err = std::fma(a, b, -product);
+}
+
+// grows a nonoverlapping expansion from the exact products f[i][0] * f[i][1]
+// and returns its sign; e needs room for two components per product
+static int signOfProductSum(const double (*factors)[2], int count, double *e)
+{
+    // drop zero components; the last component is the largest and carries
+    // the sign
+    int length = 0;
+    auto grow = [&](double term) {
+        int out = 0;
+        double q = term;
+        for (int i = 0; i < length; ++i) {
+            double sum, err;
+            twoSum(q, e[i], sum, err);
+            if (err != 0) e[out++] = err;
+            q = sum;
+        }
+        if (q != 0) e[out++] = q;
+        length = out;
+    };
+    for (int i = 0; i < count; ++i) {
+        double product, err;
+        twoProduct(factors[i][0], factors[i][1], product, err);
+        grow(err);
+        grow(product);
+    }
+
+    if (length == 0) return 0;
+    return e[length - 1] > 0 ? 1 : -1;
+}
+
+int orientationExact(double ox, double oy, double ax, double ay, double bx, double by)
+{
+    // expanding the differences gives six products whose sum is the exact
+    // determinant: ax*by - ax*oy - ox*by - ay*bx + ay*ox + oy*bx
+    const double factors[6][2] = {
+        { ax,  by}, {-ax,  oy}, {-ox,  by},
+        {-ay,  bx}, { ay,  ox}, { oy,  bx},
+    };
+
+    double e[12];
+    return signOfProductSum(factors, 6, e);
+}
+
+int compareSideDistanceExact(double px, double py, double qx, double qy,
+                             double ax, double ay, double bx, double by)
+{
+    // qx*ay - qx*by - px*ay + px*by - qy*ax + qy*bx + py*ax - py*bx
+    const double factors[8][2] = {
+        { qx,  ay}, {-qx,  by}, {-px,  ay}, { px,  by},
+        {-qy,  ax}, { qy,  bx}, { py,  ax}, {-py,  bx},
+    };
+    double e[16];
+    return signOfProductSum(factors, 8, e);
+}
+
+} // namespace hull
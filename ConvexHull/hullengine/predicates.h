@@ -0,0 +1,98 @@
+#ifndef HULL_PREDICATES_H
+#define HULL_PREDICATES_H
+
+#include "geometry.h"
+#include <cmath>
+#include <type_traits>
+
+// Robust orientation test after Shewchuk's adaptive predicates. The common
+// case is the plain double cross product plus one comparison against an
+// error bound; only when the result is too close to zero to trust is it
+// recomputed exactly with expansion arithmetic. Exact for all finite input
+// as long as no intermediate product overflows or underflows. Integer
+// coordinates skip all of that: their cross product is exact in the wide
+// type from CoordTraits.
+namespace hull {
+
+// relative error bound of the double cross product, (3 + 16 eps) * eps with
+// eps = 2^-53 (Shewchuk's ccwerrboundA)
+constexpr double orientationErrorBound = (3.0 + 16.0 * 0x1p-53) * 0x1p-53;
+
+// exact sign of (ax - ox) * (by - oy) - (ay - oy) * (bx - ox)
+int orientationExact(double ox, double oy, double ax, double ay, double bx, double by);
+
+// sign of the cross product of (a - o) and (b - o): +1 when o->a->b turns
+// left (counter-clockwise), -1 when it turns right, 0 when collinear
+inline int orientation(double ox, double oy, double ax, double ay, double bx, double by)
+{
+    const double detLeft = (ax - ox) * (by - oy);
+    const double detRight = (ay - oy) * (bx - ox);
+    const double det = detLeft - detRight;
+
+    // one comparison pair decides nearly every call; terms of opposite sign
+    // or a zero term can't cancel and always clear the bound
+    const double bound = orientationErrorBound * (std::abs(detLeft) + std::abs(detRight));
+    if (det > bound) return 1;
+    if (det < -bound) return -1;
+    // both terms zero means one factor of each is exactly zero
+    if (bound == 0) return 0;
+    return orientationExact(ox, oy, ax, ay, bx, by);
+}
+
+// exact sign of (qx - px) * (ay - by) - (qy - py) * (ax - bx)
+int compareSideDistanceExact(double px, double py, double qx, double qy,
+                             double ax, double ay, double bx, double by);
+
+// compares how far a and b lie to the left of the line p->q: +1 when a is
+// farther left (or less far right) than b, -1 the other way round, 0 when
+// both are on one parallel to it. Same filter as orientation(), whose error
+// bound holds for any determinant of two rounded differences per factor.
+inline int compareSideDistance(double px, double py, double qx, double qy,
+                               double ax, double ay, double bx, double by)
+{
+    const double detLeft = (qx - px) * (ay - by);
+    const double detRight = (qy - py) * (ax - bx);
+    const double det = detLeft - detRight;
+    const double bound = orientationErrorBound * (std::abs(detLeft) + std::abs(detRight));
+    if (det > bound) return 1;
+    if (det < -bound) return -1;
+    if (bound == 0) return 0;
+    return compareSideDistanceExact(px, py, qx, qy, ax, ay, bx, by);
+}
+
+// same for any coordinate type in CoordTraits; the double overload above
+// wins for double arguments
+template <typename T>
+inline int orientation(T ox, T oy, T ax, T ay, T bx, T by)
+{
+    if constexpr (std::is_floating_point_v<T>) {
+        return orientation(double(ox), double(oy), double(ax), double(ay), double(bx), double(by));
+    } else {
+        using Wide = typename CoordTraits<T>::Wide;
+        const Wide det = (Wide(ax) - ox) * (Wide(by) - oy) - (Wide(ay) - oy) * (Wide(bx) - ox);
+        return (det > 0) - (det < 0);
+    }
+}
+
+template <typename T>
+inline int compareSideDistance(T px, T py, T qx, T qy, T ax, T ay, T bx, T by)
+{
+    if constexpr (std::is_floating_point_v<T>) {
+        return compareSideDistance(double(px), double(py), double(qx), double(qy),
+                                   double(ax), double(ay), double(bx), double(by));
+    } else {
+        using Wide = typename CoordTraits<T>::Wide;
+        const Wide det = (Wide(qx) - px) * (Wide(ay) - by) - (Wide(qy) - py) * (Wide(ax) - bx);
+        return (det > 0) - (det < 0);
+    }
+}
+
+template <typename T>
+inline int orientation(const BasicPoint<T> &o, const BasicPoint<T> &a, const BasicPoint<T> &b)
+{
+    return orientation(o.x, o.y, a.x, a.y, b.x, b.y);
+}
+
+} // namespace hull
+
+#endif // HULL_PREDICATES_H
@@ -0,0 +1,151 @@
+#include "taskpool.h"
+#include "trace.h"
+#include <algorithm>
+#include <string>
+
+namespace hull {
+
+// pool and queue the current thread works for; -1 outside any pool
+static thread_local const TaskPool *currentPool = nullptr;
+static thread_local int currentWorker = -1;
+
+TaskPool::TaskPool(int workers)
+{
+    if (workers < 0) workers = std::max(0, int(std::thread::hardware_concurrency()) - 1);
+    for (int i = 0; i <= workers; ++i) queues.push_back(std::make_unique<Queue>());
+    threads.reserve(workers);
+    for (int i = 0; i < workers; ++i) threads.emplace_back(&TaskPool::workerLoop, this, i);
+}
+
+TaskPool::~TaskPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (std::thread &t : threads) t.join();
+}
+
+TaskPool &TaskPool::global()
+{
+    static TaskPool pool;
+    return pool;
+}
+
+int TaskPool::ownQueue() const
+{
+    return currentPool == this ? currentWorker : int(queues.size()) - 1;
+}
+
+void TaskPool::submit(Task task)
+{
+    Queue &queue = *queues[ownQueue()];
+    {
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.tasks.push_back(std::move(task));
+    }
+    queued.fetch_add(1, std::memory_order_release);
+    // taking the sleep mutex orders this against a worker that just found
+    // nothing and is about to sleep, so the wake-up can't get lost
+    { std::lock_guard<std::mutex> lock(sleepMutex); }
+    wake.notify_one();
+}
+
+bool TaskPool::runOne()
+{
+    if (queued.load(std::memory_order_acquire) == 0) return false;
+
+    const int own = ownQueue();
+    const int count = int(queues.size());
+    Task task;
+    bool found = false;
+    // own deque from the back, then everybody else's from the front
+    for (int i = 0; i < count && !found; ++i) {
+        const int q = (own + i) % count;
+        Queue &queue = *queues[q];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (queue.tasks.empty()) continue;
+        if (i == 0 && currentPool == this) {
+            task = std::move(queue.tasks.back());
+            queue.tasks.pop_back();
+        } else {
+            task = std::move(queue.tasks.front());
+            queue.tasks.pop_front();
+        }
+        found = true;
+    }
+    if (!found) return false;
+
+    queued.fetch_sub(1, std::memory_order_relaxed);
+    std::exception_ptr thrown;
+    TraceSpan span("task", "pool");
+    try {
+        task.work();
+    } catch (...) {
+        thrown = std::current_exception();
+    }
+    span.stop();
+    task.group->finish(thrown);
+    return true;
+}
+
+void TaskPool::workerLoop(int index)
+{
+    currentPool = this;
+    currentWorker = index;
+    setTraceThreadName(("pool worker " + std::to_string(index + 1)).c_str());
+    while (!stopping.load(std::memory_order_relaxed)) {
+        if (runOne()) continue;
+        std::unique_lock<std::mutex> lock(sleepMutex);
+        wake.wait(lock, [this] { return stopping.load() || queued.load() > 0; });
+    }
+}
+
+void TaskGroup::run(std::function<void()> work)
+{
+    pending.fetch_add(1, std::memory_order_relaxed);
+    pool.submit({std::move(work), this});
+}
+
+void TaskGroup::wait()
+{
+    join();
+    std::exception_ptr thrown;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        std::swap(thrown, error);
+    }
+    if (thrown) std::rethrow_exception(thrown);
+}
+
+void TaskGroup::join()
+{
+    // the remaining tasks are running elsewhere; they are usually nearly
+    // done, so spin a little before paying for a sleep and a wake-up
+    const int spins = 64;
+    int idle = 0;
+    while (pending.load(std::memory_order_acquire) > 0) {
+        if (pool.runOne()) {
+            idle = 0;
+        } else if (++idle < spins) {
+            std::this_thread::yield();
+        } else {
+            std::unique_lock<std::mutex> lock(mutex);
+            done.wait(lock, [this] { return pending.load(std::memory_order_acquire) == 0; });
+        }
+    }
+    // the last finish() may still hold the mutex; don't let the owner
+    // destroy the group under it
+    std::lock_guard<std::mutex> lock(mutex);
+}
+
+void TaskGroup::finish(std::exception_ptr thrown)
+{
+    // under the mutex, so a sleeping join() can't miss the last decrement
+    std::lock_guard<std::mutex> lock(mutex);
+    if (thrown && !error) error = thrown;
+    if (pending.fetch_sub(1, std::memory_order_release) == 1) done.notify_all();
+}
+
+} // namespace hull
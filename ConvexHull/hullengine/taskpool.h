@@ -0,0 +1,111 @@
+#ifndef HULL_TASKPOOL_H
+#define HULL_TASKPOOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace hull {
+
+// Work-stealing thread pool for the parallel engines. Every worker owns a
+// deque: tasks it spawns go to the back and it takes its own work from the
+// back (newest first, still warm in cache), while idle workers steal from
+// the front of other deques (oldest first, usually the biggest pieces of a
+// recursive split). Tasks submitted from outside the pool go to a shared
+// deque every worker steals from.
+//
+// Tasks are grouped in a TaskGroup; a thread waiting on a group runs queued
+// tasks itself instead of blocking, so recursive algorithms can wait on
+// their subtasks from inside a task without starving the pool, and a pool
+// with no workers at all still makes progress. Once nothing is left to run
+// it spins briefly and then sleeps until the group's last task finishes.
+//
+// An exception thrown by a task is caught on the thread that ran it and
+// rethrown from the group's wait(); the first one wins.
+class TaskGroup;
+
+class TaskPool
+{
+public:
+    // workers < 0 uses one worker less than there are hardware threads, as
+    // the thread waiting on a group works too
+    explicit TaskPool(int workers = -1);
+    ~TaskPool();
+
+    TaskPool(const TaskPool &) = delete;
+    TaskPool &operator=(const TaskPool &) = delete;
+
+    // threads that execute tasks while somebody waits: workers plus the waiter
+    int threadCount() const { return int(threads.size()) + 1; }
+
+    // pool shared by the engines, created on first use
+    static TaskPool &global();
+
+private:
+    friend class TaskGroup;
+
+    struct Task
+    {
+        std::function<void()> work;
+        TaskGroup *group = nullptr;
+    };
+    struct Queue
+    {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    void submit(Task task);
+    // runs one queued task if there is any; false when every deque was empty
+    bool runOne();
+    void workerLoop(int index);
+    int ownQueue() const;
+
+    std::vector<std::unique_ptr<Queue>> queues; // one per worker, then the shared one
+    std::vector<std::thread> threads;
+    std::atomic<int> queued{0};
+    std::atomic<bool> stopping{false};
+    std::mutex sleepMutex;
+    std::condition_variable wake;
+};
+
+// Set of tasks that can be waited for together. The destructor waits, so
+// tasks may safely reference locals of the scope that owns the group, but it
+// drops a task's exception; call wait() to see it.
+class TaskGroup
+{
+public:
+    explicit TaskGroup(TaskPool &pool = TaskPool::global()) : pool(pool) {}
+    ~TaskGroup() { join(); }
+
+    TaskGroup(const TaskGroup &) = delete;
+    TaskGroup &operator=(const TaskGroup &) = delete;
+
+    void run(std::function<void()> work);
+    // returns once every task run() so far has finished, executing queued
+    // tasks (of any group) in the meantime; rethrows the first exception a
+    // task threw
+    void wait();
+
+private:
+    friend class TaskPool;
+
+    void join();
+    void finish(std::exception_ptr thrown);
+
+    TaskPool &pool;
+    std::atomic<int> pending{0};
+    std::mutex mutex;
+    std::condition_variable done;
+    std::exception_ptr error;
+};
+
+} // namespace hull
+
+#endif // HULL_TASKPOOL_H
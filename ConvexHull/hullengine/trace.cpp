@@ -0,0 +1,223 @@
+#include "trace.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace hull {
+
+namespace {
+
+struct TraceEvent
+{
+    const char *name;
+    const char *category;
+    std::int64_t begin;
+    std::int64_t end;
+};
+
+// one thread's ring; only its thread writes events, writeTrace() reads
+// them. A ring left from an earlier session is emptied (and resized) by its
+// own thread on the next span, so restarting never writes to another
+// thread's ring.
+struct ThreadTrace
+{
+    int id = 0;
+    std::string name;
+    std::vector<TraceEvent> ring;
+    std::atomic<std::uint64_t> session{0};
+    std::atomic<std::uint64_t> written{0}; // events ever written this session
+    // under registryMutex: the thread has exited, and writeTrace() has
+    // written its spans out since
+    bool exited = false;
+    bool read = false;
+};
+
+std::atomic<bool> enabled{false};
+std::atomic<std::uint64_t> session{0};
+std::atomic<std::size_t> ringSize{std::size_t(1) << 16};
+std::atomic<std::int64_t> epoch{0};
+
+// taken for a thread's first span and its exit, for names and by
+// writeTrace(). A ring stays registered after its thread exits, so pool
+// threads that are gone by the time the trace is written still show up in
+// it, and goes on the retired list for a later thread to take over once it
+// has been written out or belongs to an earlier session. Threads come and
+// go for the whole of a GUI session (QThreadPool lets idle ones expire), so
+// past maxRetired unread rings the oldest is taken over anyway and its
+// spans are lost.
+constexpr std::size_t maxRetired = 64;
+std::mutex registryMutex;
+std::vector<std::unique_ptr<ThreadTrace>> threads;
+std::vector<ThreadTrace *> retired; // oldest first
+int nextId = 0;
+
+// the calling thread's ring, handed to the retired list when it exits
+struct Owner
+{
+    ThreadTrace *trace = nullptr;
+    std::string name;
+
+    ~Owner();
+};
+
+thread_local Owner own;
+
+std::int64_t now()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+ThreadTrace *registerThread()
+{
+    std::lock_guard<std::mutex> lock(registryMutex);
+    const std::uint64_t current = session.load(std::memory_order_acquire);
+    auto free = std::find_if(retired.begin(), retired.end(), [current](const ThreadTrace *trace) {
+        return trace->read || trace->session.load(std::memory_order_relaxed) != current;
+    });
+    if (free == retired.end() && retired.size() >= maxRetired) free = retired.begin();
+
+    ThreadTrace *trace;
+    if (free != retired.end()) {
+        trace = *free;
+        retired.erase(free);
+        // no other thread writes to it now, and writeTrace() needs the
+        // lock; the first span empties it
+        trace->session.store(0, std::memory_order_relaxed);
+        trace->exited = false;
+        trace->read = false;
+    } else {
+        threads.push_back(std::make_unique<ThreadTrace>());
+        trace = threads.back().get();
+    }
+    trace->id = ++nextId;
+    trace->name = own.name.empty() ? "thread " + std::to_string(trace->id) : own.name;
+    return trace;
+}
+
+Owner::~Owner()
+{
+    if (!trace) return;
+    std::lock_guard<std::mutex> lock(registryMutex);
+    trace->exited = true;
+    retired.push_back(trace);
+}
+
+void record(const TraceEvent &event)
+{
+    ThreadTrace *trace = own.trace ? own.trace : (own.trace = registerThread());
+    const std::uint64_t current = session.load(std::memory_order_acquire);
+    if (trace->session.load(std::memory_order_relaxed) != current) {
+        const std::size_t size = std::max<std::size_t>(1, ringSize.load(std::memory_order_relaxed));
+        if (trace->ring.size() != size) trace->ring.assign(size, TraceEvent());
+        trace->written.store(0, std::memory_order_relaxed);
+        trace->session.store(current, std::memory_order_release);
+    }
+    const std::uint64_t written = trace->written.load(std::memory_order_relaxed);
+    trace->ring[written % trace->ring.size()] = event;
+    trace->written.store(written + 1, std::memory_order_release);
+}
+
+// s as the contents of a JSON string
+void writeEscaped(std::FILE *out, const char *s)
+{
+    for (; *s; ++s) {
+        const unsigned char c = static_cast<unsigned char>(*s);
+        if (c == '"' || c == '\\') std::fprintf(out, "\\%c", c);
+        else if (c < 0x20) std::fprintf(out, "\\u%04x", c);
+        else std::fputc(c, out);
+    }
+}
+
+} // namespace
+
+void startTracing(std::size_t eventsPerThread)
+{
+    ringSize.store(eventsPerThread, std::memory_order_relaxed);
+    epoch.store(now(), std::memory_order_relaxed);
+    session.fetch_add(1, std::memory_order_release);
+    enabled.store(true, std::memory_order_release);
+}
+
+void stopTracing()
+{
+    enabled.store(false, std::memory_order_release);
+}
+
+bool tracingEnabled()
+{
+    return enabled.load(std::memory_order_relaxed);
+}
+
+bool writeTrace(const char *path)
+{
+    std::FILE *out = std::fopen(path, "w");
+    if (!out) return false;
+
+    const std::uint64_t current = session.load(std::memory_order_acquire);
+    const std::int64_t start = epoch.load(std::memory_order_relaxed);
+    std::fprintf(out, "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [\n");
+    bool first = true;
+    auto separator = [&] {
+        std::fputs(first ? "  " : ",\n  ", out);
+        first = false;
+    };
+    std::lock_guard<std::mutex> lock(registryMutex);
+    for (const std::unique_ptr<ThreadTrace> &trace : threads) {
+        if (trace->session.load(std::memory_order_acquire) != current) continue;
+        separator();
+        std::fprintf(out, "{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 1, \"tid\": %d, \"args\": {\"name\": \"",
+                     trace->id);
+        writeEscaped(out, trace->name.c_str());
+        std::fputs("\"}}", out);
+
+        // the newest ring.size() events, oldest first
+        const std::uint64_t written = trace->written.load(std::memory_order_acquire);
+        const std::uint64_t size = trace->ring.size();
+        for (std::uint64_t e = written > size ? written - size : 0; e < written; ++e) {
+            const TraceEvent &event = trace->ring[e % size];
+            // spans begun before a restart
+            if (event.begin < start) continue;
+            separator();
+            std::fputs("{\"name\": \"", out);
+            writeEscaped(out, event.name);
+            std::fputs("\", \"cat\": \"", out);
+            writeEscaped(out, event.category);
+            std::fprintf(out, "\", \"ph\": \"X\", \"pid\": 1, \"tid\": %d, \"ts\": %.3f, \"dur\": %.3f}",
+                         trace->id, (event.begin - start) * 1e-3, (event.end - event.begin) * 1e-3);
+        }
+        if (trace->exited) trace->read = true;
+    }
+    std::fputs("\n]}\n", out);
+    const bool ok = !std::ferror(out);
+    return std::fclose(out) == 0 && ok;
+}
+
+void setTraceThreadName(const char *name)
+{
+    own.name = name;
+    if (own.trace) {
+        std::lock_guard<std::mutex> lock(registryMutex);
+        own.trace->name = own.name;
+    }
+}
+
+TraceSpan::TraceSpan(const char *name, const char *category)
+    : name(name), category(category)
+{
+    if (enabled.load(std::memory_order_relaxed)) start = now();
+}
+
+void TraceSpan::stop()
+{
+    if (start < 0) return;
+    record({name, category, start, now()});
+    start = -1;
+}
+
+} // namespace hull
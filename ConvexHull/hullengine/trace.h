@@ -0,0 +1,63 @@
+#ifndef HULL_TRACE_H
+#define HULL_TRACE_H
+
+#include <cstddef>
+#include <cstdint>
+
+namespace hull {
+
+// Timeline tracing in the Chrome Trace Event format, which chrome://tracing
+// and ui.perfetto.dev both load. Spans are recorded per thread into a ring
+// buffer only that thread writes to, so recording takes no lock and no
+// atomic read-modify-write: two clock reads, one slot store and one release
+// store of the ring's write count. A thread's ring is allocated on its
+// first span after startTracing(); when it wraps the oldest spans are
+// overwritten, so a long session keeps its most recent stretch. The ring of
+// a thread that exits is kept until writeTrace() has written it out, for at
+// most 64 such threads, and then goes to the next new thread.
+//
+// With tracing off a span costs one relaxed atomic load. The engines trace
+// their entry points and every PhaseTimer phase, the task pool traces every
+// task it runs, and the apps add their own spans (paint, I/O).
+
+// starts (or restarts, dropping what was recorded) tracing with room for
+// eventsPerThread spans per thread
+void startTracing(std::size_t eventsPerThread = std::size_t(1) << 16);
+// spans that start after this aren't recorded
+void stopTracing();
+bool tracingEnabled();
+
+// Writes everything recorded so far to path as Chrome Trace Event JSON;
+// false when the file can't be written. Rings are read without locking out
+// their writers, so call it once traced work has finished, typically after
+// stopTracing().
+bool writeTrace(const char *path);
+
+// name of the calling thread in the trace, e.g. "pool worker 2"; threads
+// without one show up as "thread N"
+void setTraceThreadName(const char *name);
+
+// Records the scope it lives in as one span on the calling thread. name and
+// category are stored as pointers and must outlive the trace, as string
+// literals and the engines' display names do.
+class TraceSpan
+{
+public:
+    TraceSpan(const char *name, const char *category);
+    ~TraceSpan() { stop(); }
+
+    TraceSpan(const TraceSpan &) = delete;
+    TraceSpan &operator=(const TraceSpan &) = delete;
+
+    // ends the span early; later calls do nothing
+    void stop();
+
+private:
+    const char *name;
+    const char *category;
+    std::int64_t start = -1; // steady clock nanoseconds, -1 when not recording
+};
+
+} // namespace hull
+
+#endif // HULL_TRACE_H
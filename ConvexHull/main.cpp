@@ -1,10 +1,36 @@
 #include <QApplication>
+#include "cli.h"
 #include "mainwindow.h"
+#include "trace.h"
 
 int main(int argc, char *argv[])
 {
+    // batch runs must not need a display, so decide before Qt starts
+    if (isCliInvocation(argc, argv))
+        return runCli(argc, argv);
+
+    // CONVEXHULL_TRACE=session.json records the session as a Chrome trace,
+    // written on exit
+    const QByteArray tracePath = qgetenv("CONVEXHULL_TRACE");
+    if (!tracePath.isEmpty()) {
+        hull::setTraceThreadName("gui");
+        hull::startTracing();
+    }
+
     QApplication a(argc, argv);
-    MainWindow w;
-    w.show();
-    return a.exec();
+    int status;
+    {
+        // the window waits for every hull run it started, cancelled ones
+        // included, so nothing is still tracing when the trace is written
+        MainWindow w;
+        w.show();
+        status = a.exec();
+    }
+
+    if (!tracePath.isEmpty()) {
+        hull::stopTracing();
+        if (!hull::writeTrace(tracePath.constData()))
+            qWarning("cannot write trace %s", tracePath.constData());
+    }
+    return status;
 }
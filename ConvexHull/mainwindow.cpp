@@ -1,9 +1,14 @@
 #include "mainwindow.h"
 #include "drawingwidget.h"
 #include <QPushButton>
+#include <QProgressBar>
+#include <QComboBox>
+#include <QCheckBox>
+#include <QSpinBox>
 #include <QVBoxLayout>
 #include <QHBoxLayout>
 #include <QWidget>
+#include <limits>
 
 MainWindow::MainWindow(QWidget *parent)
     : QMainWindow(parent)
@@ -14,20 +19,115 @@ MainWindow::MainWindow(QWidget *parent)
     drawing = new DrawingWidget(this);
     drawing->setMinimumSize(640, 480);
 
+    // engine for the fast (blue) hull
+    algorithmBox = new QComboBox(this);
+    algorithmBox->addItem("Graham scan", int(hull::Algorithm::GrahamScan));
+    algorithmBox->addItem("Monotone chain", int(hull::Algorithm::MonotoneChain));
+    algorithmBox->addItem("Parallel Graham", int(hull::Algorithm::ParallelGraham));
+    algorithmBox->addItem("Chan", int(hull::Algorithm::Chan));
+    algorithmBox->addItem("QuickHull", int(hull::Algorithm::QuickHull));
+
+    // engine for the reference (red) hull
+    referenceBox = new QComboBox(this);
+    referenceBox->addItem("Brute force", int(hull::Reference::BruteForce));
+    referenceBox->addItem("Gift wrapping", int(hull::Reference::GiftWrapping));
+    referenceBox->setToolTip("Reference hull the fast one is checked against; gift wrapping handles far larger inputs");
+
+    prefilterBox = new QCheckBox("Prefilter", this);
+    prefilterBox->setToolTip("Drop points inside the octagon of extreme points before running the engines");
+
+    radixBox = new QCheckBox("Radix sort", this);
+    radixBox->setToolTip("Graham engines sort by a packed pseudo-angle key with a radix sort instead of std::sort");
+
+    parallelSortBox = new QSpinBox(this);
+    parallelSortBox->setRange(1024, 1 << 30);
+    parallelSortBox->setSingleStep(16384);
+    parallelSortBox->setValue(drawing->parallelSortThreshold());
+    parallelSortBox->setPrefix("Parallel sort from ");
+    parallelSortBox->setSuffix(" points");
+    parallelSortBox->setToolTip("Graham engines sort inputs at least this large on all cores");
+
+    liveBox = new QCheckBox("Live hull", this);
+    liveBox->setToolTip("Keep a hull that updates on every click without running the engines"
+                       " (up to 10000 points)");
+
+    // synthetic clouds instead of clicking points in one by one
+    distributionBox = new QComboBox(this);
+    for (int d = 0; d < hull::distributionCount; ++d)
+        distributionBox->addItem(hull::distributionName(hull::Distribution(d)), d);
+    countBox = new QSpinBox(this);
+    countBox->setRange(1, 100000000);
+    countBox->setValue(100000);
+    countBox->setGroupSeparatorShown(true);
+    countBox->setSuffix(" points");
+    seedBox = new QSpinBox(this);
+    seedBox->setRange(0, std::numeric_limits<int>::max());
+    seedBox->setValue(1);
+    seedBox->setPrefix("Seed ");
+    seedBox->setToolTip("The same distribution, count and seed always give the same points");
+    generateButton = new QPushButton("Generate", this);
+
     runButton = new QPushButton("Run Convex Hull", this);
     clearButton = new QPushButton("Clear", this);
+    cancelButton = new QPushButton("Cancel", this);
+    cancelButton->setEnabled(false);
+
+    progressBar = new QProgressBar(this);
+    progressBar->setRange(0, 100);
+    progressBar->setValue(0);
+    progressBar->setVisible(false);
 
     QHBoxLayout *hButtons = new QHBoxLayout;
+    hButtons->addWidget(algorithmBox);
+    hButtons->addWidget(referenceBox);
+    hButtons->addWidget(prefilterBox);
+    hButtons->addWidget(radixBox);
+    hButtons->addWidget(parallelSortBox);
+    hButtons->addWidget(liveBox);
     hButtons->addWidget(runButton);
     hButtons->addWidget(clearButton);
+    hButtons->addWidget(cancelButton);
+    hButtons->addWidget(progressBar);
     hButtons->addStretch();
 
+    QHBoxLayout *generateRow = new QHBoxLayout;
+    generateRow->addWidget(distributionBox);
+    generateRow->addWidget(countBox);
+    generateRow->addWidget(seedBox);
+    generateRow->addWidget(generateButton);
+    generateRow->addStretch();
+
     QVBoxLayout *layout = new QVBoxLayout;
     layout->addWidget(drawing);
     layout->addLayout(hButtons);
+    layout->addLayout(generateRow);
 
     central->setLayout(layout);
 
     connect(runButton, &QPushButton::clicked, drawing, &DrawingWidget::runBothAlgorithms);
     connect(clearButton, &QPushButton::clicked, drawing, &DrawingWidget::clearAll);
+    connect(cancelButton, &QPushButton::clicked, drawing, &DrawingWidget::cancelRun);
+    connect(algorithmBox, QOverload<int>::of(&QComboBox::currentIndexChanged), this, [this](int index) {
+        drawing->setFastAlgorithm(hull::Algorithm(algorithmBox->itemData(index).toInt()));
+    });
+    connect(referenceBox, QOverload<int>::of(&QComboBox::currentIndexChanged), this, [this](int index) {
+        drawing->setReferenceAlgorithm(hull::Reference(referenceBox->itemData(index).toInt()));
+    });
+    connect(prefilterBox, &QCheckBox::toggled, drawing, &DrawingWidget::setPrefilterEnabled);
+    connect(radixBox, &QCheckBox::toggled, drawing, &DrawingWidget::setRadixSortEnabled);
+    connect(parallelSortBox, QOverload<int>::of(&QSpinBox::valueChanged),
+            drawing, &DrawingWidget::setParallelSortThreshold);
+    connect(liveBox, &QCheckBox::toggled, drawing, &DrawingWidget::setLiveHullEnabled);
+    connect(drawing, &DrawingWidget::liveHullEnabledChanged, liveBox, &QCheckBox::setChecked);
+    connect(generateButton, &QPushButton::clicked, this, [this]() {
+        drawing->generatePoints(hull::Distribution(distributionBox->currentData().toInt()),
+                                countBox->value(), quint64(seedBox->value()));
+    });
+
+    // hulls are computed on a worker thread; reflect its state here
+    connect(drawing, &DrawingWidget::progressChanged, progressBar, &QProgressBar::setValue);
+    connect(drawing, &DrawingWidget::runningChanged, this, [this](bool running) {
+        cancelButton->setEnabled(running);
+        progressBar->setVisible(running);
+    });
 }
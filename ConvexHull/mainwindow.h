@@ -5,6 +5,10 @@
 
 class DrawingWidget;
 class QPushButton;
+class QProgressBar;
+class QComboBox;
+class QCheckBox;
+class QSpinBox;
 class QHBoxLayout;
 class QVBoxLayout;
 
@@ -17,8 +21,20 @@ public:
 private:
     DrawingWidget *drawing;
     QWidget *central;
+    QComboBox *algorithmBox;
+    QComboBox *referenceBox;
+    QCheckBox *prefilterBox;
+    QCheckBox *radixBox;
+    QSpinBox *parallelSortBox;
+    QCheckBox *liveBox;
+    QComboBox *distributionBox;
+    QSpinBox *countBox;
+    QSpinBox *seedBox;
+    QPushButton *generateButton;
     QPushButton *runButton;
     QPushButton *clearButton;
+    QPushButton *cancelButton;
+    QProgressBar *progressBar;
 };
 
 #endif // MAINWINDOW_H
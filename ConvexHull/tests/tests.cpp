@@ -0,0 +1,730 @@
+// Randomized checks of the hull engines, the dynamic hull and the
+// orientation predicate against an exact oracle. Every point is an integer
+// key (kx, ky) mapped to the coordinate type by a positive scale and an
+// offset that are exact in that type, so the oracle can decide every
+// orientation on the keys with 128-bit integers while the code under test
+// sees int32, int64, float or double coordinates. The task pool and the
+// tracer get direct checks of their own.
+//
+//   hulltests [--seed S] [--rounds N]
+//
+// Prints every mismatch with the case that caused it and exits with 1 when
+// there was any.
+
+#include "dynamichull.h"
+#include "generator.h"
+#include "hullengine.h"
+#include "instrument.h"
+#include "orientkernel.h"
+#include "predicates.h"
+#include "taskpool.h"
+#include "trace.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#ifndef HULL_HAVE_INT128
+#error "the oracle needs a 128-bit integer type"
+#endif
+
+namespace {
+
+using Key = std::pair<std::int64_t, std::int64_t>;
+
+std::atomic<int> checks{0};
+std::atomic<int> failures{0};
+std::mutex reportMutex;
+
+void fail(const std::string &what)
+{
+    failures.fetch_add(1);
+    std::lock_guard<std::mutex> lock(reportMutex);
+    std::fprintf(stderr, "FAIL %s\n", what.c_str());
+}
+
+void check(bool ok, const std::string &what)
+{
+    checks.fetch_add(1);
+    if (!ok) fail(what);
+}
+
+// ---- oracle ----
+
+int sign(__int128 v)
+{
+    return v > 0 ? 1 : v < 0 ? -1 : 0;
+}
+
+int exactOrientation(const Key &o, const Key &a, const Key &b)
+{
+    const __int128 left = (__int128(a.first) - o.first) * (__int128(b.second) - o.second);
+    const __int128 right = (__int128(a.second) - o.second) * (__int128(b.first) - o.first);
+    return sign(left - right);
+}
+
+// monotone chain over the keys: distinct vertices counter-clockwise from the
+// lexicographically smallest, collinear boundary points excluded
+std::vector<Key> oracleHull(std::vector<Key> keys)
+{
+    std::sort(keys.begin(), keys.end());
+    keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+    const int m = int(keys.size());
+    if (m < 3) return keys;
+    std::vector<Key> st(2 * m);
+    int k = 0;
+    for (int i = 0; i < m; ++i) {
+        while (k >= 2 && exactOrientation(st[k-2], st[k-1], keys[i]) <= 0) --k;
+        st[k++] = keys[i];
+    }
+    for (int i = m - 2, lower = k + 1; i >= 0; --i) {
+        while (k >= lower && exactOrientation(st[k-2], st[k-1], keys[i]) <= 0) --k;
+        st[k++] = keys[i];
+    }
+    st.resize(k - 1);
+    return st;
+}
+
+// ---- inputs ----
+
+struct Random
+{
+    std::uint64_t state;
+
+    std::uint64_t next()
+    {
+        std::uint64_t z = (state += 0x9e3779b97f4a7c15ull);
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+        return z ^ (z >> 31);
+    }
+    // uniform in [-range, range]
+    std::int64_t between(std::int64_t range)
+    {
+        return std::int64_t(next() % std::uint64_t(2 * range + 1)) - range;
+    }
+};
+
+// the shapes most likely to trip a hull: heavy duplicates and collinear
+// runs on a tiny grid, vertical and horizontal lines, a single line, one
+// repeated point, a circle (every point a vertex) and plain random points
+std::vector<Key> makeKeys(Random &rng, int shape, int n, std::int64_t range)
+{
+    std::vector<Key> keys(n);
+    const std::int64_t small = std::min<std::int64_t>(range, 4);
+    for (int i = 0; i < n; ++i) {
+        Key &k = keys[i];
+        switch (shape) {
+        case 0: k = {rng.between(small), rng.between(small)}; break;
+        case 1: k = {rng.between(1) * range, rng.between(range)}; break;
+        case 2: k = {rng.between(range), rng.between(1) * range}; break;
+        case 3: {
+            const std::int64_t t = rng.between(range / 8);
+            k = {3 * t, -5 * t};
+            break;
+        }
+        case 4: k = {range / 3, -range / 5}; break;
+        case 5: {
+            // integer points near a circle, on the hull unless rounding
+            // dents it
+            const double a = double(i) / n * 6.283185307179586;
+            k = {std::int64_t(std::cos(a) * double(range)), std::int64_t(std::sin(a) * double(range))};
+            break;
+        }
+        default: k = {rng.between(range), rng.between(range)}; break;
+        }
+    }
+    return keys;
+}
+constexpr int shapeCount = 7;
+constexpr int randomShape = shapeCount - 1;
+
+// exact key -> coordinate maps and the key range each stays exact and in
+// range for (see CoordTraits)
+template <typename T> struct Coordinates;
+
+template <> struct Coordinates<std::int32_t>
+{
+    static constexpr const char *name = "int32";
+    static constexpr std::int64_t range = std::int64_t(1) << 29;
+    static std::int32_t from(std::int64_t k) { return std::int32_t(k); }
+};
+
+template <> struct Coordinates<std::int64_t>
+{
+    static constexpr const char *name = "int64";
+    static constexpr std::int64_t range = std::int64_t(1) << 29;
+    static std::int64_t from(std::int64_t k) { return k * (std::int64_t(1) << 32); }
+};
+
+template <> struct Coordinates<float>
+{
+    static constexpr const char *name = "float";
+    static constexpr std::int64_t range = std::int64_t(1) << 23;
+    static float from(std::int64_t k) { return float(k) * 0x1p-8f; }
+};
+
+template <> struct Coordinates<double>
+{
+    static constexpr const char *name = "double";
+    static constexpr std::int64_t range = std::int64_t(1) << 40;
+    // off the origin so differences cancel digits, as in real inputs
+    static double from(std::int64_t k) { return double(k) * 0x1p-12 + 0x1p20; }
+};
+
+template <typename T>
+hull::BasicPointStore<T> toPoints(const std::vector<Key> &keys)
+{
+    hull::BasicPointStore<T> points;
+    for (const Key &k : keys) points.append(Coordinates<T>::from(k.first), Coordinates<T>::from(k.second));
+    return points;
+}
+
+// hull given as ids into keys, rotated to start at its smallest key; empty
+// when an id is out of range or repeated
+std::vector<Key> normalized(const std::vector<int> &ids, const std::vector<Key> &keys)
+{
+    std::vector<Key> out;
+    std::vector<char> seen(keys.size(), 0);
+    for (int i : ids) {
+        if (i < 0 || i >= int(keys.size()) || seen[i]) return {{-1, -1}};
+        seen[i] = 1;
+        out.push_back(keys[i]);
+    }
+    if (!out.empty()) std::rotate(out.begin(), std::min_element(out.begin(), out.end()), out.end());
+    return out;
+}
+
+std::string describe(const char *type, int shape, int n, std::uint64_t seed)
+{
+    return std::string(type) + " shape " + std::to_string(shape) + " n " + std::to_string(n)
+         + " seed " + std::to_string(seed);
+}
+
+// ---- engines ----
+
+// every selectable fast engine
+const hull::Algorithm algorithms[] = {hull::Algorithm::GrahamScan, hull::Algorithm::MonotoneChain,
+                                      hull::Algorithm::ParallelGraham, hull::Algorithm::Chan,
+                                      hull::Algorithm::QuickHull};
+
+template <typename T>
+void checkEngines(const std::vector<Key> &keys, const hull::BasicPointStore<T> &points, const std::string &label,
+                  hull::Arena &arena)
+{
+    const std::vector<Key> expected = oracleHull(keys);
+    const hull::BasicPointsView<T> view = points.view();
+    const int n = int(keys.size());
+    std::vector<int> out;
+    std::int64_t iterations = 0;
+
+    // the default options, then each knob changed
+    const int variants = 4;
+    for (int variant = 0; variant < variants; ++variant) {
+        hull::HullOptions options;
+        if (variant == 1) options.angularSort = hull::AngularSort::Radix;
+        if (variant == 2) {
+            arena.reset();
+            options.arena = &arena;
+        }
+        if (variant == 3) options.countIterations = false;
+        const std::string suffix = " variant " + std::to_string(variant) + " " + label;
+        for (hull::Algorithm algorithm : algorithms) {
+            hull::computeHull(algorithm, view, iterations, out, nullptr, options);
+            check(normalized(out, keys) == expected && (options.countIterations || iterations == 0),
+                  hull::algorithmName(algorithm) + suffix);
+        }
+        hull::computeReference(hull::Reference::GiftWrapping, view, iterations, out, nullptr, options);
+        check(normalized(out, keys) == expected, "gift wrapping" + suffix);
+        // brute force is O(n^3)
+        if (n <= 200) {
+            hull::computeReference(hull::Reference::BruteForce, view, iterations, out, nullptr, options);
+            check(normalized(out, keys) == expected, "brute force" + suffix);
+        }
+    }
+
+    // prefilter, then a hull of the survivors mapped back
+    hull::BasicPointStore<T> survivors;
+    std::vector<int> originalIndex;
+    hull::aklToussaintFilter(view, survivors, originalIndex);
+    hull::computeMonotoneChain(survivors.view(), iterations, out);
+    for (int &i : out) i = originalIndex[i];
+    check(normalized(out, keys) == expected, "Akl-Toussaint filter " + label);
+}
+
+// the batch engine over sets cut from keys at random offsets, empty ones
+// included
+template <typename T>
+void checkBatch(const std::vector<Key> &keys, const hull::BasicPointStore<T> &points, Random &rng,
+                const std::string &label, const hull::HullOptions &options = hull::HullOptions())
+{
+    const int n = int(keys.size());
+    std::vector<int> offsets = {0};
+    while (offsets.back() < n)
+        offsets.push_back(std::min<int>(n, offsets.back() + int(rng.next() % 40)));
+    const hull::BasicPointSets<T> sets{points.view(), offsets.data(), offsets.size() - 1};
+    hull::HullSets out;
+    std::int64_t iterations = 0;
+    hull::computeHulls(sets, iterations, out, nullptr, options);
+    bool ok = out.count() == sets.count;
+    for (std::size_t s = 0; ok && s < sets.count; ++s) {
+        const std::vector<Key> part(keys.begin() + offsets[s], keys.begin() + offsets[s + 1]);
+        std::vector<int> ids(out.indices.begin() + out.offsets[s], out.indices.begin() + out.offsets[s + 1]);
+        for (int &i : ids) i -= offsets[s];
+        ok = normalized(ids, part) == oracleHull(part);
+    }
+    check(ok, "batch " + label);
+}
+
+// a run with a control gives the same hull and ends at 100 percent; a run
+// cancelled up front stops after its first step
+void checkControl(std::uint64_t seed)
+{
+    Random rng{seed};
+    const std::vector<Key> keys = makeKeys(rng, randomShape, 300, Coordinates<double>::range);
+    const hull::PointStore points = toPoints<double>(keys);
+    const hull::PointsView view = points.view();
+    std::vector<int> out;
+    std::int64_t full = 0;
+    std::int64_t iterations = 0;
+
+    hull::RunControl control;
+    hull::computeSlowConvexHull(view, full, out, &control);
+    check(normalized(out, keys) == oracleHull(keys) && control.progress.load() == 100,
+          "brute force with a control");
+    hull::RunControl grahamControl;
+    hull::computeGrahamScan(view, iterations, out, &grahamControl);
+    check(normalized(out, keys) == oracleHull(keys) && grahamControl.progress.load() == 100,
+          "Graham with a control");
+
+    hull::RunControl cancelled;
+    cancelled.cancelled = true;
+    hull::computeSlowConvexHull(view, iterations, out, &cancelled);
+    check(iterations < full / 100, "cancelled brute force ran " + std::to_string(iterations) + " iterations");
+}
+
+// ---- predicates ----
+
+// k points a few units off a line through the origin with slope p / q <= 1,
+// with 50-bit coordinates, where the double cross product is useless and
+// the exact path decides
+void nearLine(Random &rng, Key *k, int count)
+{
+    const std::int64_t range = std::int64_t(1) << 50;
+    std::int64_t p = 1 + std::int64_t(rng.next() % 1000);
+    std::int64_t q = 1 + std::int64_t(rng.next() % 1000);
+    if (p > q) std::swap(p, q);
+    for (int i = 0; i < count; ++i) {
+        const std::int64_t x = rng.between(range);
+        k[i] = {x, x / q * p + rng.between(2)};
+    }
+}
+
+void checkPredicates(std::uint64_t seed, int rounds)
+{
+    Random rng{seed};
+    int wrong = 0;
+    for (int i = 0; i < 20000 * rounds; ++i) {
+        Key k[4];
+        nearLine(rng, k, 4);
+        auto d = [](const Key &key, int c) { return double(c ? key.second : key.first); };
+        const int o = hull::orientation(d(k[0], 0), d(k[0], 1), d(k[1], 0), d(k[1], 1), d(k[2], 0), d(k[2], 1));
+        if (o != exactOrientation(k[0], k[1], k[2])) ++wrong;
+
+        // (q - p) x (a - b) on the keys
+        const __int128 left = (__int128(k[1].first) - k[0].first) * (__int128(k[2].second) - k[3].second);
+        const __int128 right = (__int128(k[1].second) - k[0].second) * (__int128(k[2].first) - k[3].first);
+        const int c = hull::compareSideDistance(d(k[0], 0), d(k[0], 1), d(k[1], 0), d(k[1], 1),
+                                                d(k[2], 0), d(k[2], 1), d(k[3], 0), d(k[3], 1));
+        if (c != sign(left - right)) ++wrong;
+    }
+    check(wrong == 0, "adaptive predicates: " + std::to_string(wrong) + " wrong signs");
+}
+
+// every side-scan kernel against the oracle on near-collinear points, on
+// lengths around the vector and block widths so the tails are covered
+void checkKernels(std::uint64_t seed)
+{
+    Random rng{seed};
+    const hull::SimdLevel levels[] = {hull::SimdLevel::Scalar, hull::SimdLevel::Avx2, hull::SimdLevel::Avx512};
+    int wrong = 0;
+    for (int n = 0; n <= 70; ++n) {
+        for (int trial = 0; trial < 20; ++trial) {
+            std::vector<Key> k(n + 2);
+            nearLine(rng, k.data(), n + 2);
+            // every other trial moves all points to the left of the line, so
+            // that the scans run to the end
+            const bool oneSided = trial % 2 == 0;
+            std::vector<double> x(n), y(n);
+            bool pos = false, neg = false;
+            for (int i = 0; i < n; ++i) {
+                int o = exactOrientation(k[n], k[n + 1], k[i]);
+                if (oneSided && o < 0) {
+                    // reflect through the line's first point
+                    k[i] = {2 * k[n].first - k[i].first, 2 * k[n].second - k[i].second};
+                    o = -o;
+                }
+                x[i] = double(k[i].first);
+                y[i] = double(k[i].second);
+                pos |= o > 0;
+                neg |= o < 0;
+            }
+            for (hull::SimdLevel level : levels) {
+                const hull::SideScan scan = hull::sideScanKernel(level)(
+                    x.data(), y.data(), std::size_t(n),
+                    double(k[n].first), double(k[n].second), double(k[n + 1].first), double(k[n + 1].second));
+                if (scan.pos != pos || scan.neg != neg) ++wrong;
+            }
+        }
+    }
+    check(wrong == 0, "side-scan kernels (best here: " + std::string(hull::simdLevelName(hull::detectSimdLevel()))
+          + "): " + std::to_string(wrong) + " wrong scans");
+}
+
+// Inputs big enough for the parallel engines to split them, run on a pool
+// with real workers: four chunks of 32768 points, each above the parallel
+// hull's and the parallel sort's minimum chunk, QuickHull halves well above
+// its minimum task, and batch sets dealt out as sixteen tasks. The shapes
+// are the ones where a split is most likely to go wrong: duplicates across
+// chunks, a vertical line, a single line, a circle (every QuickHull level
+// splits) and random points.
+template <typename T>
+void checkLarge(std::uint64_t seed, hull::TaskPool &pool)
+{
+    Random rng{seed};
+    const int shapes[] = {0, 1, 3, 5, randomShape};
+    for (int shape : shapes) {
+        const std::uint64_t caseSeed = rng.next();
+        Random caseRng{caseSeed};
+        const std::vector<Key> keys = makeKeys(caseRng, shape, 1 << 17, Coordinates<T>::range);
+        const std::vector<Key> expected = oracleHull(keys);
+        const hull::BasicPointStore<T> points = toPoints<T>(keys);
+        const hull::BasicPointsView<T> view = points.view();
+        const std::string label = describe(Coordinates<T>::name, shape, int(keys.size()), caseSeed);
+        const std::string threads = " on " + std::to_string(pool.threadCount()) + " threads ";
+        std::vector<int> out;
+        std::int64_t iterations = 0;
+        // the tasks of one run also share an arena, on the second pass, which
+        // also leaves counting off
+        hull::Arena arena;
+        for (hull::Arena *scratch : {static_cast<hull::Arena *>(nullptr), &arena}) {
+            hull::HullOptions options;
+            options.pool = &pool;
+            options.arena = scratch;
+            options.countIterations = !scratch;
+            const std::string suffix = threads + (scratch ? "with an arena, uncounted " : "") + label;
+
+            arena.reset();
+            hull::computeParallelHull(view, iterations, out, nullptr, 0, options);
+            check(normalized(out, keys) == expected, "parallel hull" + suffix);
+            arena.reset();
+            hull::computeQuickHull(view, iterations, out, nullptr, options);
+            check(normalized(out, keys) == expected, "quickhull" + suffix);
+            // above the threshold: four sorted chunks, then two rounds of merges
+            arena.reset();
+            hull::computeGrahamScan(view, iterations, out, nullptr, options);
+            check(normalized(out, keys) == expected, "Graham with a parallel sort" + suffix);
+            options.angularSort = hull::AngularSort::Radix;
+            arena.reset();
+            hull::computeGrahamScan(view, iterations, out, nullptr, options);
+            check(normalized(out, keys) == expected, "radix Graham" + suffix);
+            arena.reset();
+            checkBatch<T>(keys, points, caseRng, suffix, options);
+        }
+
+        // the chunks profile into profiles of their own, merged afterwards:
+        // one pivot search per chunk plus one for the merge
+        hull::RunProfile profile;
+        hull::HullOptions options;
+        options.pool = &pool;
+        options.profile = &profile;
+        hull::computeParallelHull(view, iterations, out, nullptr, 0, options);
+        const int chunks = std::min(pool.threadCount(), int(keys.size() >> 14));
+        check(normalized(out, keys) == expected && profile[hull::Phase::PivotSearch].calls == chunks + 1,
+              "profiled parallel hull" + threads + label);
+    }
+}
+
+// ---- dynamic hull ----
+
+// Inserts every point, then deletes them in random order the way the GUI
+// does: the last point moves into the freed slot and is relabelled. The hull
+// is compared with the oracle after every step on small inputs and every
+// 16th on large ones.
+template <typename T>
+void checkDynamic(std::vector<Key> keys, hull::BasicPointStore<T> points, Random &rng, const std::string &label)
+{
+    hull::BasicDynamicHull<T> dynamic;
+    std::vector<int> out;
+    const int n = int(keys.size());
+    bool ok = true;
+    auto compare = [&](int count) {
+        dynamic.vertices(out);
+        const std::vector<Key> current(keys.begin(), keys.begin() + count);
+        ok &= normalized(out, current) == oracleHull(current) && dynamic.size() == std::size_t(count);
+    };
+    for (int i = 0; i < n; ++i) {
+        dynamic.insert(points.xs()[i], points.ys()[i], i);
+        if (n <= 100 || i % 16 == 15) compare(i + 1);
+    }
+    compare(n);
+    check(ok, "dynamic hull insert " + label);
+
+    for (int last = n - 1; last >= 0; --last) {
+        const int i = int(rng.next() % std::uint64_t(last + 1));
+        ok &= dynamic.remove(points.xs()[i], points.ys()[i], i);
+        if (i != last) ok &= dynamic.relabel(points.xs()[last], points.ys()[last], last, i);
+        points.set(i, points.xs()[last], points.ys()[last]);
+        points.resize(last);
+        keys[i] = keys[last];
+        keys.resize(last);
+        if (last <= 100 || last % 16 == 0) compare(last);
+    }
+    check(ok && dynamic.empty() && !dynamic.remove(T(0), T(0), 0),
+          "dynamic hull delete " + label);
+}
+
+// Points at and next to the largest integer coordinates CoordTraits allows,
+// where the cross products only just fit their wide type. The keys are the
+// coordinates themselves.
+template <typename T>
+void checkLimits(std::uint64_t seed)
+{
+    const std::int64_t limit = hull::CoordTraits<T>::limit;
+    Random rng{seed};
+    hull::Arena arena;
+    for (int trial = 0; trial < 20; ++trial) {
+        std::vector<Key> keys(trial < 10 ? 6 : 200);
+        for (Key &k : keys) {
+            // corners and edges of the allowed square, some just inside
+            auto edge = [&] {
+                const std::int64_t inside = std::int64_t(rng.next() % 3);
+                return rng.next() & 1 ? limit - inside : inside - limit;
+            };
+            auto any = [&] { return rng.next() & 1 ? edge() : rng.between(limit); };
+            k = rng.next() & 1 ? Key{edge(), any()} : Key{any(), edge()};
+        }
+        hull::BasicPointStore<T> points;
+        for (const Key &k : keys) points.append(T(k.first), T(k.second));
+        const std::string label = describe(Coordinates<T>::name, -1, int(keys.size()), seed)
+                                + " at the coordinate limit, trial " + std::to_string(trial);
+        checkEngines<T>(keys, points, label, arena);
+        checkBatch<T>(keys, points, rng, label);
+        checkDynamic<T>(keys, points, rng, label);
+    }
+}
+
+// Clouds generated straight into integer coordinates with bounds reaching
+// past the exact range: every point is clamped into it and the engines
+// still match the oracle on what comes out. The same arguments give the
+// same points.
+template <typename T>
+void checkGenerator(std::uint64_t seed)
+{
+    const double limit = double(hull::CoordTraits<T>::limit);
+    const hull::GenerateBounds bounds{-1.5 * limit, -1.5 * limit, 3 * limit, 3 * limit};
+    hull::Arena arena;
+    for (int d = 0; d < hull::distributionCount; ++d) {
+        const hull::Distribution distribution = hull::Distribution(d);
+        hull::BasicPointStore<T> points, again;
+        hull::generatePoints(distribution, seed, 1000, points, bounds);
+        hull::generatePoints(distribution, seed, 1000, again, bounds);
+        const std::string label = std::string(Coordinates<T>::name) + " " + hull::distributionName(distribution)
+                                + " seed " + std::to_string(seed);
+        check(hull::inExactRange(points.view()), "generated points in the exact range " + label);
+        check(std::equal(points.xs(), points.xs() + points.size(), again.xs())
+                  && std::equal(points.ys(), points.ys() + points.size(), again.ys()),
+              "generated points repeat " + label);
+
+        std::vector<Key> keys(points.size());
+        for (std::size_t i = 0; i < keys.size(); ++i) keys[i] = {points.xs()[i], points.ys()[i]};
+        checkEngines<T>(keys, points, "generated " + label, arena);
+    }
+}
+
+template <typename T>
+void checkType(std::uint64_t seed, int rounds)
+{
+    Random rng{seed};
+    hull::Arena arena;
+    const char *type = Coordinates<T>::name;
+    const int sizes[] = {0, 1, 2, 3, 5, 17, 100, 1000};
+    for (int round = 0; round < rounds; ++round) {
+        for (int shape = 0; shape < shapeCount; ++shape) {
+            for (int n : sizes) {
+                const std::uint64_t caseSeed = rng.next();
+                Random caseRng{caseSeed};
+                const std::int64_t range = Coordinates<T>::range >> (caseRng.next() % 20);
+                const std::vector<Key> keys = makeKeys(caseRng, shape, n, std::max<std::int64_t>(range, 8));
+                const hull::BasicPointStore<T> points = toPoints<T>(keys);
+                const std::string label = describe(type, shape, n, caseSeed);
+                checkEngines<T>(keys, points, label, arena);
+                checkBatch<T>(keys, points, caseRng, label);
+                checkDynamic<T>(keys, points, caseRng, label);
+            }
+        }
+    }
+}
+
+// ---- thread pool ----
+
+// the engines from many tasks at once, nested in task groups of their own,
+// and exceptions thrown by tasks at either level
+void checkPool(std::uint64_t seed, hull::TaskPool &pool)
+{
+    std::atomic<int> sum{0};
+    {
+        hull::TaskGroup outer(pool);
+        for (int t = 0; t < 64; ++t) {
+            outer.run([&pool, &sum, t, seed] {
+                Random rng{seed + std::uint64_t(t)};
+                const std::vector<Key> keys = makeKeys(rng, t % shapeCount, 2000, std::int64_t(1) << 29);
+                const std::string label = "pool task " + std::to_string(t);
+                hull::Arena arena;
+                checkEngines<double>(keys, toPoints<double>(keys), label, arena);
+                checkDynamic<std::int32_t>(keys, toPoints<std::int32_t>(keys), rng, label);
+                hull::TaskGroup inner(pool);
+                for (int i = 0; i < 8; ++i) inner.run([&sum] { sum.fetch_add(1); });
+            });
+        }
+    }
+    check(sum.load() == 64 * 8, "pool: nested tasks ran " + std::to_string(sum.load()) + " times");
+
+    // every task runs to completion, wait() rethrows one of the exceptions
+    // and the group is usable again afterwards
+    sum = 0;
+    hull::TaskGroup group(pool);
+    for (int t = 0; t < 64; ++t) {
+        group.run([&pool, &sum, t] {
+            sum.fetch_add(1);
+            if (t % 8 == 3) throw std::runtime_error("task");
+            if (t % 8 == 5) {
+                hull::TaskGroup inner(pool);
+                inner.run([] { throw std::runtime_error("nested task"); });
+                inner.wait();
+            }
+        });
+    }
+    std::string thrown;
+    try {
+        group.wait();
+    } catch (const std::runtime_error &e) {
+        thrown = e.what();
+    }
+    check((thrown == "task" || thrown == "nested task") && sum.load() == 64,
+          "pool: exceptions from tasks, caught '" + thrown + "' after " + std::to_string(sum.load()) + " tasks");
+    group.run([&sum] { sum.fetch_add(1); });
+    bool again = false;
+    try {
+        group.wait();
+    } catch (...) {
+        again = true;
+    }
+    check(!again && sum.load() == 65, "pool: group after an exception");
+}
+
+// names of the threads in the trace at path, in file order
+std::vector<std::string> traceThreads(const char *path)
+{
+    std::vector<std::string> names;
+    std::FILE *in = std::fopen(path, "r");
+    if (!in) return names;
+    std::string text;
+    char buffer[4096];
+    for (std::size_t n; (n = std::fread(buffer, 1, sizeof buffer, in)) > 0;) text.append(buffer, n);
+    std::fclose(in);
+    const std::string marker = "\"thread_name\"";
+    const std::string field = "\"args\": {\"name\": \"";
+    for (std::size_t at = text.find(marker); at != std::string::npos; at = text.find(marker, at + 1)) {
+        const std::size_t begin = text.find(field, at) + field.size();
+        names.push_back(text.substr(begin, text.find('"', begin) - begin));
+    }
+    return names;
+}
+
+// rings of exited threads are kept until written out, at most 64 of them,
+// and then taken over by new threads
+void checkTrace()
+{
+    const char *path = "hulltests-trace.json";
+    auto spawn = [](int first, int count) {
+        for (int t = first; t < first + count; ++t) {
+            std::thread([t] {
+                hull::setTraceThreadName(("t" + std::to_string(t)).c_str());
+                hull::TraceSpan span("span", "test");
+            }).join();
+        }
+    };
+
+    hull::startTracing(16);
+    spawn(0, 200);
+    check(hull::writeTrace(path), "trace: writing the file");
+    std::vector<std::string> names = traceThreads(path);
+    bool newest = names.size() == 64;
+    for (int t = 136; t < 200; ++t)
+        newest = newest && std::count(names.begin(), names.end(), "t" + std::to_string(t)) == 1;
+    check(newest, "trace: " + std::to_string(names.size()) + " threads kept of 200, 64 newest expected");
+
+    // all of them were read, so new threads take their rings over
+    spawn(200, 10);
+    hull::writeTrace(path);
+    names = traceThreads(path);
+    check(names.size() == 64 && std::count(names.begin(), names.end(), "t209") == 1,
+          "trace: " + std::to_string(names.size()) + " threads after reusing read rings");
+
+    // a restart makes every retired ring free
+    hull::startTracing(16);
+    spawn(210, 1);
+    hull::stopTracing();
+    hull::writeTrace(path);
+    names = traceThreads(path);
+    check(names.size() == 1 && names[0] == "t210", "trace: threads after a restart");
+    std::remove(path);
+}
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    std::uint64_t seed = 1;
+    int rounds = 2;
+    for (int i = 1; i < argc; ++i) {
+        if (!std::strcmp(argv[i], "--seed") && i + 1 < argc) {
+            seed = std::strtoull(argv[++i], nullptr, 10);
+        } else if (!std::strcmp(argv[i], "--rounds") && i + 1 < argc) {
+            rounds = std::max(1, std::atoi(argv[++i]));
+        } else {
+            std::fprintf(stderr, "usage: hulltests [--seed S] [--rounds N]\n");
+            return 2;
+        }
+    }
+
+    checkType<std::int32_t>(seed, rounds);
+    checkType<std::int64_t>(seed + 1, rounds);
+    checkType<float>(seed + 2, rounds);
+    checkType<double>(seed + 3, rounds);
+    checkLimits<std::int32_t>(seed + 4);
+    checkLimits<std::int64_t>(seed + 5);
+    checkGenerator<std::int32_t>(seed + 12);
+    checkGenerator<std::int64_t>(seed + 13);
+    checkControl(seed + 6);
+    // a pool of its own, as the global one has no workers on a single core
+    hull::TaskPool pool(3);
+    checkLarge<std::int32_t>(seed + 7, pool);
+    checkLarge<double>(seed + 8, pool);
+    checkPredicates(seed + 9, rounds);
+    checkKernels(seed + 10);
+    checkPool(seed + 11, pool);
+    checkTrace();
+
+    std::printf("%d checks, %d failures\n", checks.load(), failures.load());
+    return failures.load() == 0 ? 0 : 1;
+}
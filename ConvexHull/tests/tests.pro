@@ -0,0 +1,12 @@
+# Randomized oracle checks of the hull engines and the dynamic hull, plus
+# the predicates, the task pool and tracing. Needs no Qt, like
+# hullengine.pro:
+#   qmake tests.pro && make check
+TEMPLATE = app
+TARGET   = hulltests
+CONFIG  += console c++17 thread testcase
+CONFIG  -= qt app_bundle
+
+SOURCES += tests.cpp
+
+include(../hullengine/hullengine.pri)